@@ -20,10 +20,12 @@ struct BenchmarkResult {
 
 // Clase Benchmark - Compara el desempeño de algoritmos de búsqueda de patrones
 //
-// Compara tres algoritmos:
-// - Suffix Array: O(n log n) construcción, O(m log n) búsqueda
+// Compara los algoritmos de búsqueda:
+// - Suffix Array: O(n) construcción, O(m log n + occ) búsqueda
 // - KMP: O(m) construcción, O(n) búsqueda
 // - Boyer-Moore: O(m + σ) construcción, O(n) búsqueda (σ = tamaño del alfabeto)
+// - Escáner SIMD: sin construcción, O(n) búsqueda con 16 o 32 posiciones por
+//   instrucción
 //
 // El Suffix Array es especialmente eficiente cuando se realizan múltiples
 // búsquedas sobre el mismo texto, ya que el costo de construcción se amortiza.
@@ -36,6 +38,206 @@ public:
   static std::vector<BenchmarkResult> compare_all(const std::string &text,
                                                   const std::string &pattern);
 
+  // Compara los algoritmos de construcción del Suffix Array (duplicación vs
+  // SA-IS) sobre el mismo texto. La búsqueda se mide con el patrón dado.
+  // @param text Texto a indexar
+  // @param pattern Patrón a buscar
+  // @return Vector con un resultado por algoritmo de construcción
+  static std::vector<BenchmarkResult>
+  compare_construction(const std::string &text, const std::string &pattern);
+
+  // Mide la construcción paralela del Suffix Array con cada número de hilos
+  // @param text Texto a indexar
+  // @param thread_counts Números de hilos a probar
+  // @return Un resultado por número de hilos (más SA-IS secuencial como base)
+  static std::vector<BenchmarkResult>
+  construction_scaling(const std::string &text,
+                       const std::vector<unsigned> &thread_counts);
+
+  // Compara el costo de cada ancho de índice del Suffix Array (32, 40 y 64
+  // bits): tiempo de construcción y búsqueda, y memoria del arreglo
+  // @param text Texto a indexar
+  // @param pattern Patrón a buscar
+  // @return Un resultado por ancho de índice
+  static std::vector<BenchmarkResult>
+  compare_index_widths(const std::string &text, const std::string &pattern);
+
+  // Compara la búsqueda binaria simple con la acelerada por LCP-LR
+  // El tiempo de búsqueda es el promedio de equal_range por patrón; la
+  // construcción de LCP-LR incluye el cálculo del LCP Array.
+  // @param text Texto a indexar
+  // @param patterns Patrones a buscar (idealmente largos)
+  // @return Un resultado por modo de búsqueda
+  static std::vector<BenchmarkResult>
+  compare_search_modes(const std::string &text,
+                       const std::vector<std::string> &patterns);
+
+  // Compara search_batch con un ciclo de consultas individuales
+  // El tiempo de búsqueda es el total del lote; la construcción es la del SA
+  // @param text Texto a indexar
+  // @param patterns Consultas del lote
+  // @param threads Hilos para el lote paralelo (0 = núcleos disponibles)
+  // @return Ciclo simple, lote en un hilo y lote paralelo
+  static std::vector<BenchmarkResult>
+  compare_batch_search(const std::string &text,
+                       const std::vector<std::string> &patterns,
+                       unsigned threads = 0);
+
+  // Compara la búsqueda sin tabla de buckets con tablas de k = 2 y k = 3
+  // La memoria reportada es la de la tabla; la búsqueda es el promedio de
+  // equal_range por patrón
+  // @param text Texto a indexar
+  // @param patterns Patrones a buscar (de al menos 3 caracteres)
+  // @return Un resultado por configuración
+  static std::vector<BenchmarkResult>
+  compare_prefix_tables(const std::string &text,
+                        const std::vector<std::string> &patterns);
+
+  // Compara el arranque construyendo el Suffix Array contra abrir un índice
+  // guardado con save() y mapeado con open(). La construcción reportada es
+  // el tiempo hasta tener el índice listo; la búsqueda es la primera
+  // consulta, que con mmap incluye cargar las páginas que toca.
+  // @param text Texto a indexar
+  // @param pattern Patrón a buscar
+  // @param path Archivo temporal para el índice (se borra al terminar)
+  // @return Construcción, guardado, apertura y apertura con verificación
+  static std::vector<BenchmarkResult>
+  compare_startup(const std::string &text, const std::string &pattern,
+                  const std::string &path = "benchmark_index.sa");
+
+  // Compara la ingesta de un texto que llega por bloques: agregar cada bloque
+  // al SuffixTree (Ukkonen en línea) contra reconstruir el Suffix Array de
+  // todo el texto tras cada bloque. La construcción es el tiempo total de
+  // ingesta; la búsqueda, una consulta sobre el texto completo.
+  // @param text Texto completo
+  // @param chunk Tamaño de cada bloque agregado
+  // @param pattern Patrón a buscar al final
+  // @return Árbol con append y Suffix Array reconstruido
+  static std::vector<BenchmarkResult>
+  compare_append(const std::string &text, size_t chunk,
+                 const std::string &pattern);
+
+  // Construcción de un índice en disco: en memoria (Suffix Array + save)
+  // contra build_external con un presupuesto de memoria. La construcción es
+  // el tiempo hasta tener el archivo escrito; la búsqueda, una consulta sobre
+  // el índice abierto con open(). La memoria es el pico de trabajo (arreglos
+  // en memoria, o el reportado por build_external). También imprime el pico
+  // de memoria residente de cada fase (Linux) y el volumen de E/S.
+  // @param text Texto a indexar
+  // @param memory_budget Presupuesto de memoria de build_external en bytes
+  // @param pattern Patrón a buscar
+  // @param path Archivo temporal para el índice (se borra al terminar)
+  // @return Construcción en memoria y en memoria externa
+  static std::vector<BenchmarkResult>
+  compare_external(const std::string &text, size_t memory_budget,
+                   const std::string &pattern,
+                   const std::string &path = "benchmark_external.sa");
+
+  // Búsqueda lineal sin índice: KMP, Boyer-Moore, std::string::find y
+  // SimdSearch con cada núcleo que admite la CPU. Todas recuperan todas las
+  // ocurrencias; no hay construcción.
+  // @param text Texto donde buscar
+  // @param pattern Patrón a buscar
+  // @return Un resultado por algoritmo
+  static std::vector<BenchmarkResult> compare_scan(const std::string &text,
+                                                   const std::string &pattern);
+
+  // Micro-benchmark de SuffixCompare::mismatch: dos cadenas iguales salvo
+  // el último byte, comparadas con cada núcleo que admite la CPU. La
+  // búsqueda es el tiempo de comparar ~64 MB en total por fila.
+  // @param prefix_lengths Longitudes del prefijo común a probar
+  // @return Un resultado por núcleo y longitud
+  static std::vector<BenchmarkResult>
+  compare_mismatch(const std::vector<size_t> &prefix_lengths);
+
+  // LCP (Kasai) y búsqueda de un patrón largo con cada núcleo de
+  // SuffixCompare. Con un texto repetitivo los prefijos comunes son largos.
+  // La búsqueda es el promedio de count(pattern).
+  // @param text Texto a indexar
+  // @param pattern Patrón a buscar
+  // @return Un resultado por núcleo
+  static std::vector<BenchmarkResult>
+  compare_lcp_kernels(const std::string &text, const std::string &pattern);
+
+  // Compara el Suffix Array con el FM-index: memoria contra latencia
+  // Para cada índice mide count y locate (promedio por patrón). La memoria
+  // del Suffix Array incluye el texto, que el FM-index no necesita.
+  // @param text Texto a indexar
+  // @param patterns Patrones a buscar
+  // @param sample_rate Muestreo del Suffix Array dentro del FM-index
+  // @return count y locate para cada índice
+  static std::vector<BenchmarkResult>
+  compare_fm_index(const std::string &text,
+                   const std::vector<std::string> &patterns,
+                   unsigned sample_rate = 32);
+
+  // Compara el LCP en caché (Kasai, con arreglo inverso) con la variante
+  // compacta (Φ, un byte por entrada). La memoria es la que queda ocupada
+  // después de calcularlo; la búsqueda no se mide.
+  // @param text Texto a indexar
+  // @return Un resultado por variante
+  static std::vector<BenchmarkResult>
+  compare_lcp_variants(const std::string &text);
+
+  // Compara la detección de plagio entre N documentos: un PlagiarismDetector
+  // por par contra un solo MultiDocumentDetector. La construcción incluye
+  // todos los índices; la búsqueda es el tiempo de análisis.
+  // @param documents Documentos a comparar entre sí
+  // @param min_match_length Longitud mínima de un fragmento común
+  // @return Un resultado por estrategia
+  static std::vector<BenchmarkResult>
+  compare_multi_document(const std::vector<std::string> &documents,
+                         int min_match_length = 10);
+
+  // Compara el cálculo de matching statistics (coincidencia más larga de
+  // cada posición de la consulta) con búsqueda binaria sobre la longitud en
+  // cada posición. La construcción del motor incluye LCP, inverso y árbol.
+  // @param text Texto a indexar
+  // @param query Consulta
+  // @return Búsqueda binaria, motor secuencial y motor paralelo
+  static std::vector<BenchmarkResult>
+  compare_matching_statistics(const std::string &text,
+                              const std::string &query);
+
+  // Compara el análisis exacto de todos los pares de un corpus con el filtro
+  // de huellas (winnowing) seguido del análisis exacto de los candidatos.
+  // Imprime los pares sospechosos (similitud >= threshold) y el recall del
+  // filtro respecto del análisis exacto.
+  // @param documents Corpus a comparar
+  // @param threshold Similitud mínima (0-100) para considerar sospechoso un
+  // par
+  // @param min_match_length Longitud mínima de un fragmento común
+  // @return Análisis exacto de todos los pares y filtro + análisis exacto
+  static std::vector<BenchmarkResult>
+  compare_prefilter(const std::vector<std::string> &documents,
+                    double threshold = 5.0, int min_match_length = 10);
+
+  // Compara un documento contra un corpus de referencia: un
+  // PlagiarismDetector por documento del corpus contra un CorpusIndex
+  // construido una vez (y también guardado y abierto con mmap). La
+  // construcción incluye todos los índices y la primera consulta, que
+  // prepara el motor; la búsqueda es una segunda consulta.
+  // @param corpus Documentos de referencia
+  // @param query Documento sospechoso
+  // @param min_match_length Longitud mínima de un fragmento común
+  // @param path Archivo temporal para el índice (se borra al terminar)
+  // @return Un resultado por estrategia
+  static std::vector<BenchmarkResult>
+  compare_corpus_query(const std::vector<std::string> &corpus,
+                       const std::string &query, int min_match_length = 10,
+                       const std::string &path = "benchmark_corpus.sa");
+
+  // Mide el detector de plagio sobre un par de documentos: construcción
+  // (texto combinado, Suffix Array y LCP) y cada modo de análisis (completo,
+  // métrica en caché, top-10, streaming y solo similitud)
+  // @param text1 Primer documento
+  // @param text2 Segundo documento
+  // @param min_match_length Longitud mínima de un fragmento común
+  // @return Un resultado por modo, con la memoria retenida en coincidencias
+  static std::vector<BenchmarkResult>
+  measure_plagiarism(const std::string &text1, const std::string &text2,
+                     int min_match_length = 10);
+
   // Imprime los resultados en formato tabla
   // @param results Vector de resultados a imprimir
   static void print_results(const std::vector<BenchmarkResult> &results);
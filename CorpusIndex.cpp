@@ -0,0 +1,296 @@
+#include "CorpusIndex.h"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+// Cabecera del archivo de límites (path + ".docs"), seguida de count + 1
+// posiciones de 64 bits: el inicio de cada documento y el final del texto
+struct DocsFileHeader {
+  char magic[8];                  // "SADOCS\0\0"
+  std::uint32_t version;          // Versión del formato
+  std::uint32_t min_match_length; // Longitud mínima con la que se creó
+  std::uint64_t text_size;        // Tamaño del texto del índice asociado
+  std::uint64_t count;            // Número de documentos
+};
+
+constexpr char kDocsMagic[8] = {'S', 'A', 'D', 'O', 'C', 'S', 0, 0};
+// Versión 2: min_match_length ocupa el campo antes reservado
+constexpr std::uint32_t kDocsVersion = 2;
+
+// Cobertura acumulada de la consulta respecto de un documento. Las ventanas
+// llegan en orden creciente de posición, así que basta el final de la última.
+struct Coverage {
+  std::size_t covered = 0;
+  std::size_t end = 0;
+
+  void add(std::size_t begin, std::size_t stop) {
+    covered += stop - std::max(end, begin);
+    end = stop;
+  }
+};
+
+// Inicio de cada documento en el texto unido, más el final
+std::vector<std::size_t> boundaries(const std::vector<std::string> &documents) {
+  std::vector<std::size_t> starts;
+  starts.reserve(documents.size() + 1);
+  std::size_t offset = 0;
+  for (const auto &document : documents) {
+    starts.push_back(offset);
+    offset += document.size() + 1;
+  }
+  starts.push_back(offset);
+  return starts;
+}
+
+// Une los documentos, cada uno seguido de '\0'
+std::string join(const std::vector<std::string> &documents) {
+  std::size_t total = 0;
+  for (const auto &document : documents)
+    total += document.size() + 1;
+
+  std::string text;
+  text.reserve(total);
+  for (const auto &document : documents) {
+    if (document.find('\0') != std::string::npos)
+      throw std::invalid_argument(
+          "CorpusIndex: un documento contiene el separador '\\0'");
+    text += document;
+    text += '\0';
+  }
+  return text;
+}
+
+} // namespace
+
+// Constructor: une los documentos con '\0' y construye el Suffix Array
+CorpusIndex::CorpusIndex(const std::vector<std::string> &documents,
+                         int min_match_length)
+    : starts_(boundaries(documents)), sa_(join(documents)),
+      min_match_length_(std::max(min_match_length, 1)),
+      engine_(std::make_shared<QueryEngine>(sa_)) {}
+
+CorpusIndex::CorpusIndex(SuffixArray sa, std::vector<std::size_t> starts,
+                         int min_match_length)
+    : starts_(std::move(starts)), sa_(std::move(sa)),
+      min_match_length_(std::max(min_match_length, 1)),
+      engine_(std::make_shared<QueryEngine>(sa_)) {}
+
+// Guarda el índice y, aparte, los límites de los documentos
+void CorpusIndex::save(const std::string &path) const {
+  sa_.save(path);
+
+  DocsFileHeader header{};
+  std::memcpy(header.magic, kDocsMagic, sizeof(kDocsMagic));
+  header.version = kDocsVersion;
+  header.min_match_length = static_cast<std::uint32_t>(min_match_length_);
+  header.text_size = sa_.n();
+  header.count = document_count();
+  std::vector<std::uint64_t> starts(starts_.begin(), starts_.end());
+
+  std::string docs_path = path + ".docs";
+  std::ofstream out(docs_path, std::ios::binary | std::ios::trunc);
+  if (!out)
+    throw std::runtime_error("CorpusIndex::save: no se pudo crear " +
+                             docs_path);
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char *>(starts.data()),
+            static_cast<std::streamsize>(starts.size() * sizeof(starts[0])));
+  if (!out)
+    throw std::runtime_error("CorpusIndex::save: error al escribir " +
+                             docs_path);
+}
+
+// Mapea el índice y lee los límites, comprobando que correspondan a él
+CorpusIndex CorpusIndex::open(const std::string &path, bool verify) {
+  SuffixArray sa = SuffixArray::open(path, verify);
+
+  std::string docs_path = path + ".docs";
+  auto fail = [&](const std::string &reason) {
+    return std::runtime_error("CorpusIndex::open: " + docs_path + ": " +
+                              reason);
+  };
+  std::ifstream in(docs_path, std::ios::binary);
+  if (!in)
+    throw fail("no se pudo abrir");
+
+  DocsFileHeader header;
+  if (!in.read(reinterpret_cast<char *>(&header), sizeof(header)))
+    throw fail("archivo demasiado corto");
+  if (std::memcmp(header.magic, kDocsMagic, sizeof(kDocsMagic)) != 0)
+    throw fail("no es un archivo de documentos");
+  if (header.version != kDocsVersion)
+    throw fail("versión de formato no soportada");
+  if (header.text_size != sa.n() || header.count > sa.n())
+    throw fail("no corresponde al índice " + path);
+  if (header.min_match_length == 0 ||
+      header.min_match_length >
+          static_cast<std::uint32_t>(std::numeric_limits<int>::max()))
+    throw fail("longitud mínima no válida");
+
+  std::vector<std::uint64_t> starts(header.count + 1);
+  if (!in.read(reinterpret_cast<char *>(starts.data()),
+               static_cast<std::streamsize>(starts.size() * sizeof(starts[0]))))
+    throw fail("archivo demasiado corto");
+
+  // Los límites deben crecer, empezar en 0 y terminar en el final del texto,
+  // y cada documento debe ir seguido de su separador
+  std::string_view text = sa.text();
+  if (starts.front() != 0 || starts.back() != text.size())
+    throw fail("límites de documentos no válidos");
+  for (std::size_t d = 0; d < header.count; ++d)
+    if (starts[d + 1] <= starts[d] || text[starts[d + 1] - 1] != '\0')
+      throw fail("límites de documentos no válidos");
+
+  return CorpusIndex(std::move(sa),
+                     std::vector<std::size_t>(starts.begin(), starts.end()),
+                     static_cast<int>(header.min_match_length));
+}
+
+// Fila anterior del mismo documento para cada fila del SA y su árbol de
+// mínimos, además de las estadísticas de coincidencia
+const CorpusIndex::QueryEngine &CorpusIndex::engine() const {
+  QueryEngine &engine = *engine_;
+  std::call_once(engine.once, [&] {
+    engine.statistics = std::make_unique<MatchingStatistics>(engine.sa);
+    std::span<const int> sa = engine.sa.sa();
+    std::vector<int> last(document_count(), -1);
+    engine.previous.resize(sa.size());
+    for (std::size_t row = 0; row < sa.size(); ++row) {
+      int document = document_of(static_cast<std::size_t>(sa[row]));
+      engine.previous[row] = last[document];
+      last[document] = static_cast<int>(row);
+    }
+
+    while (engine.leaves < sa.size())
+      engine.leaves *= 2;
+    engine.tree.assign(2 * engine.leaves, std::numeric_limits<int>::max());
+    std::copy(engine.previous.begin(), engine.previous.end(),
+              engine.tree.begin() + engine.leaves);
+    for (std::size_t node = engine.leaves - 1; node >= 1; --node)
+      engine.tree[node] =
+          std::min(engine.tree[2 * node], engine.tree[2 * node + 1]);
+  });
+  return engine;
+}
+
+int CorpusIndex::document_of(std::size_t position) const {
+  return static_cast<int>(
+      std::upper_bound(starts_.begin(), starts_.end(), position) -
+      starts_.begin() - 1);
+}
+
+// Recorre la consulta con las estadísticas de coincidencia y acumula la
+// cobertura de cada ventana presente, en total y por documento
+CorpusIndex::QueryReport CorpusIndex::query(std::string_view text,
+                                            unsigned threads) const {
+  QueryReport report{0, 0.0, {}};
+  std::size_t m = static_cast<std::size_t>(min_match_length_);
+  if (text.size() < m)
+    return report;
+
+  const QueryEngine &engine = this->engine();
+  MatchingStatistics::Result statistics =
+      threads == 1 ? engine.statistics->compute(text)
+                   : engine.statistics->compute_parallel(text, threads);
+  std::span<const int> sa = engine.sa.sa();
+
+  // Documentos distintos de [lo, hi): las filas con previous < lo, bajando
+  // solo por los nodos del árbol cuyo mínimo es < lo
+  std::vector<int> documents;
+  std::vector<std::pair<std::size_t, std::size_t>> pending;
+  auto list_documents = [&](std::size_t lo, std::size_t hi) {
+    documents.clear();
+    int bound = static_cast<int>(lo);
+    pending.assign(1, {1, 0});
+    while (!pending.empty()) {
+      auto [node, first] = pending.back();
+      pending.pop_back();
+      std::size_t width = engine.leaves >> (std::bit_width(node) - 1);
+      if (first >= hi || first + width <= lo || engine.tree[node] >= bound)
+        continue;
+      if (node >= engine.leaves) {
+        documents.push_back(document_of(static_cast<std::size_t>(sa[first])));
+        continue;
+      }
+      pending.push_back({2 * node + 1, first + width / 2});
+      pending.push_back({2 * node, first});
+    }
+  };
+
+  // Si todas las apariciones de la ventana en i siguen con text[i + m] y la
+  // ventana en i + 1 tiene tantas como ella, son las mismas desplazadas y
+  // están en los mismos documentos. Esas ventanas forman un tramo
+  // [run_begin, run_end) y sus documentos se listan una sola vez.
+  // Los tramos y las ventanas llegan en orden de posición, como espera
+  // Coverage. next_nul es la primera posición con '\0' en o después de i.
+  Coverage total;
+  std::unordered_map<int, Coverage> by_document;
+  std::size_t run_begin = 0, run_end = 0, run_count = 0;
+  bool continues = false; // La ventana anterior sigue entera en esta
+  auto close_run = [&] {
+    for (int document : documents)
+      by_document[document].add(run_begin, run_end);
+    documents.clear();
+  };
+  std::size_t next_nul = text.find('\0');
+  for (std::size_t i = 0; i + m <= text.size(); ++i) {
+    if (next_nul < i)
+      next_nul = text.find('\0', i);
+    if (statistics.lengths[i] < m || next_nul < i + m) {
+      continues = false;
+      continue;
+    }
+    total.add(i, i + m);
+
+    auto interval = statistics.intervals[i];
+    auto [lo, hi] = engine.statistics->prefix_interval(interval, m);
+    if (continues && hi - lo == run_count) {
+      run_end = i + m;
+    } else {
+      close_run();
+      run_begin = i;
+      run_end = i + m;
+      run_count = hi - lo;
+      list_documents(lo, hi);
+    }
+    if (statistics.lengths[i] > m) {
+      auto [next_lo, next_hi] =
+          engine.statistics->prefix_interval(interval, m + 1);
+      continues = next_hi - next_lo == run_count;
+    } else {
+      continues = false;
+    }
+  }
+  close_run();
+
+  double length = static_cast<double>(text.size());
+  report.covered = total.covered;
+  report.similarity = 100.0 * report.covered / length;
+  report.documents.reserve(by_document.size());
+  for (const auto &[document, coverage] : by_document)
+    report.documents.push_back(
+        {document, coverage.covered, 100.0 * coverage.covered / length});
+  std::sort(report.documents.begin(), report.documents.end(),
+            [](const DocumentMatch &a, const DocumentMatch &b) {
+              if (a.covered != b.covered)
+                return a.covered > b.covered;
+              return a.document < b.document;
+            });
+  return report;
+}
+
+std::size_t CorpusIndex::document_count() const { return starts_.size() - 1; }
+
+std::string_view CorpusIndex::document(std::size_t i) const {
+  return sa_.text().substr(starts_[i], starts_[i + 1] - starts_[i] - 1);
+}
+
+int CorpusIndex::min_match_length() const { return min_match_length_; }
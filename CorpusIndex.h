@@ -0,0 +1,119 @@
+#ifndef CORPUSINDEX_H
+#define CORPUSINDEX_H
+
+#pragma once
+#include "MatchingStatistics.h"
+#include "SuffixArray.h"
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Clase CorpusIndex - Un documento sospechoso contra un corpus de referencia
+//
+// Comparar un documento con cada uno de los D documentos del corpus usando
+// PlagiarismDetector construye D Suffix Arrays, y cada uno vuelve a ordenar
+// el lado del corpus. CorpusIndex indexa el corpus una sola vez (y puede
+// guardarlo en disco y abrirlo con mmap); cada consulta solo busca en ese
+// índice, con un coste que depende del tamaño de la consulta y de los
+// documentos que coinciden, y solo logarítmicamente del corpus.
+//
+// Funcionamiento:
+// 1. Une los documentos del corpus con '\0' y construye su Suffix Array
+// 2. Recorre la consulta una vez con MatchingStatistics: para cada posición
+//    i obtiene la coincidencia más larga y su rango en el SA, extendido de
+//    forma incremental desde el de i - 1. La ventana de min_match_length
+//    caracteres en i aparece en el corpus si esa coincidencia la cubre sin
+//    pasar por un '\0', así que nunca cruza el límite entre dos documentos
+// 3. La cobertura es la unión de las ventanas que aparecen en el corpus, la
+//    misma que la de los fragmentos maximales de al menos min_match_length
+// 4. El rango de cada ventana se reparte entre sus documentos distintos
+//    (Muthukrishnan): con la fila anterior del mismo documento para cada
+//    fila, la primera de cada documento en [lo, hi) es la que tiene esa
+//    fila anterior < lo, y se encuentran con un árbol de mínimos sin
+//    recorrer todas las apariciones. Si todas las apariciones de una
+//    ventana continúan en la siguiente y esta no tiene más, los documentos
+//    son los mismos y no se vuelven a listar.
+class CorpusIndex {
+public:
+  // Cobertura de la consulta respecto de un documento del corpus
+  struct DocumentMatch {
+    int document;        // Índice del documento en el corpus
+    std::size_t covered; // Caracteres de la consulta presentes en él
+    double similarity;   // Porcentaje de la consulta presente en él (0-100)
+  };
+
+  // Resultado de una consulta
+  struct QueryReport {
+    std::size_t covered; // Caracteres de la consulta presentes en el corpus
+    double similarity;   // Porcentaje de la consulta presente (0-100)
+    // Documentos con alguna coincidencia, de mayor a menor cobertura
+    std::vector<DocumentMatch> documents;
+  };
+
+  // Constructor: une los documentos y construye el índice
+  // min_match_length: longitud mínima de un fragmento común (por defecto 10)
+  // Lanza std::invalid_argument si algún documento contiene '\0' y
+  // std::length_error si el corpus no cabe en índices de 32 bits
+  explicit CorpusIndex(const std::vector<std::string> &documents,
+                       int min_match_length = 10);
+
+  // Guarda el índice en path (formato de SuffixArray::save) y los límites de
+  // los documentos y min_match_length en path + ".docs"
+  // Lanza std::runtime_error si no puede escribir alguno de los archivos
+  void save(const std::string &path) const;
+
+  // Abre un índice guardado con save(): el Suffix Array se mapea en memoria
+  // sin reconstruirse y solo se leen los límites de los documentos y la
+  // longitud mínima con la que se creó
+  // Lanza std::runtime_error si alguno de los archivos no es válido
+  static CorpusIndex open(const std::string &path, bool verify = false);
+
+  // Compara una consulta con todo el corpus
+  // Las ventanas con '\0' se ignoran. threads se pasa a
+  // MatchingStatistics::compute_parallel (0 usa todos los núcleos). La
+  // primera consulta prepara el motor: LCP, arreglo inverso y fila anterior
+  // del mismo documento, O(n log D).
+  // Complejidad: O(q log n) para una consulta de q caracteres, más
+  // O(k log n) por tramo de ventanas presente en k documentos distintos
+  QueryReport query(std::string_view text, unsigned threads = 1) const;
+
+  std::size_t document_count() const;
+  std::string_view document(std::size_t i) const;
+  int min_match_length() const;
+
+private:
+  CorpusIndex(SuffixArray sa, std::vector<std::size_t> starts,
+              int min_match_length);
+
+  std::vector<std::size_t> starts_; // Inicio de cada documento (y el final)
+  SuffixArray sa_;                  // Índice del corpus unido por '\0'
+  int min_match_length_;            // Longitud mínima de coincidencia
+
+  // Motor de consultas, preparado en la primera y compartido entre copias.
+  // Guarda su propia copia del Suffix Array (comparte los datos) para que
+  // el puntero de MatchingStatistics no dependa de dónde esté el objeto.
+  struct QueryEngine {
+    explicit QueryEngine(const SuffixArray &sa) : sa(sa) {}
+
+    std::once_flag once;
+    SuffixArray sa;
+    std::unique_ptr<MatchingStatistics> statistics;
+    // previous[r] = última fila antes de r del mismo documento, o -1
+    std::vector<int> previous;
+    // Árbol de mínimos de previous: hojas en leaves..2·leaves-1
+    std::size_t leaves = 1;
+    std::vector<int> tree;
+  };
+  std::shared_ptr<QueryEngine> engine_;
+
+  // Prepara el motor si hace falta
+  const QueryEngine &engine() const;
+
+  // Documento que contiene la posición del texto unido
+  int document_of(std::size_t position) const;
+};
+
+#endif // CORPUSINDEX_H
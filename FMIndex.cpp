@@ -0,0 +1,149 @@
+#include "FMIndex.h"
+#include "SuffixArray.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+// Construye el Suffix Array con SA-IS y deriva de él el índice
+template <typename Index>
+BasicFMIndex<Index>::BasicFMIndex(std::string_view text,
+                                  unsigned sample_rate) {
+  std::vector<Index> sa = BasicSuffixArray<Index>::build_sa(text);
+  build(text, sa, sample_rate);
+}
+
+template <typename Index>
+BasicFMIndex<Index>::BasicFMIndex(std::string_view text,
+                                  std::span<const Index> sa,
+                                  unsigned sample_rate) {
+  build(text, sa, sample_rate);
+}
+
+// BWT[fila] = carácter anterior al sufijo de esa fila. El terminador, menor
+// que cualquier byte, se guarda como 0 y se descuenta aparte en occ().
+// Las filas muestreadas son las de posiciones múltiplos de sample_rate.
+template <typename Index>
+void BasicFMIndex<Index>::build(std::string_view text,
+                                std::span<const Index> sa,
+                                unsigned sample_rate) {
+  if (sample_rate == 0)
+    throw std::invalid_argument("FMIndex: sample_rate debe ser positivo");
+  if (sa.size() != text.size())
+    throw std::invalid_argument(
+        "FMIndex: el Suffix Array no corresponde al texto");
+  n_ = text.size();
+  sample_rate_ = sample_rate;
+
+  std::string bwt(n_ + 1, '\0');
+  sampled_ = RankBitVector(n_ + 1);
+  samples_.clear();
+  samples_.reserve(n_ / sample_rate + 1);
+  if (n_ > 0)
+    bwt[0] = text[n_ - 1]; // Fila 0: sufijo vacío, precedido por el último
+  for (std::size_t r = 0; r < n_; ++r) {
+    std::size_t pos = static_cast<value_type>(sa[r]);
+    if (pos == 0)
+      terminator_row_ = r + 1;
+    else
+      bwt[r + 1] = text[pos - 1];
+    if (pos % sample_rate == 0) {
+      sampled_.set(r + 1);
+      samples_.push_back(static_cast<value_type>(pos));
+    }
+  }
+  sampled_.build();
+  bwt_ = WaveletMatrix(bwt);
+
+  std::array<std::size_t, 256> counts{};
+  for (char c : text)
+    counts[static_cast<unsigned char>(c)]++;
+  c_[0] = 1; // La fila del terminador va antes que todas
+  for (int c = 0; c < 256; ++c)
+    c_[c + 1] = c_[c] + counts[c];
+}
+
+template <typename Index> std::size_t BasicFMIndex<Index>::n() const {
+  return n_;
+}
+
+template <typename Index>
+std::size_t BasicFMIndex<Index>::occ(unsigned char c, std::size_t row) const {
+  std::size_t r = bwt_.rank(c, row);
+  if (c == 0 && terminator_row_ < row)
+    r--;
+  return r;
+}
+
+// Búsqueda hacia atrás: el rango de filas que empiezan con pattern[i..] se
+// obtiene del de pattern[i+1..] con dos consultas rank
+template <typename Index>
+std::pair<std::size_t, std::size_t>
+BasicFMIndex<Index>::equal_range(std::string_view pattern) const {
+  if (pattern.empty())
+    return {0, n_};
+  std::size_t lo = 0, hi = n_ + 1;
+  for (std::size_t i = pattern.size(); i-- > 0;) {
+    unsigned char c = pattern[i];
+    lo = c_[c] + occ(c, lo);
+    hi = c_[c] + occ(c, hi);
+    if (lo >= hi)
+      return {0, 0};
+  }
+  // Ningún patrón no vacío coincide con la fila 0, así que el rango en el
+  // Suffix Array es el de filas desplazado en uno
+  return {lo - 1, hi - 1};
+}
+
+template <typename Index>
+bool BasicFMIndex<Index>::search(std::string_view pattern) const {
+  return count(pattern) > 0;
+}
+
+template <typename Index>
+std::size_t BasicFMIndex<Index>::count(std::string_view pattern) const {
+  auto [lo, hi] = equal_range(pattern);
+  return hi - lo;
+}
+
+// LF(fila) lleva al sufijo que empieza una posición antes. La posición 0
+// siempre está muestreada, así que nunca se retrocede desde el terminador.
+template <typename Index>
+typename BasicFMIndex<Index>::value_type
+BasicFMIndex<Index>::locate_row(std::size_t row) const {
+  value_type steps = 0;
+  while (!sampled_.get(row)) {
+    auto [c, rank] = bwt_.access_rank(row);
+    if (c == 0 && terminator_row_ < row)
+      rank--;
+    row = c_[c] + rank;
+    steps++;
+  }
+  return static_cast<value_type>(samples_[sampled_.rank1(row)]) + steps;
+}
+
+template <typename Index>
+std::vector<typename BasicFMIndex<Index>::value_type>
+BasicFMIndex<Index>::locate(std::string_view pattern) const {
+  auto [lo, hi] = equal_range(pattern);
+  std::vector<value_type> positions;
+  positions.reserve(hi - lo);
+  for (std::size_t r = lo; r < hi; ++r)
+    positions.push_back(locate_row(r + 1));
+  std::sort(positions.begin(), positions.end());
+  return positions;
+}
+
+template <typename Index>
+std::size_t BasicFMIndex<Index>::memory_bytes() const {
+  return sizeof(*this) + bwt_.memory_bytes() + sampled_.memory_bytes() +
+         samples_.size() * sizeof(Index);
+}
+
+template <typename Index>
+unsigned BasicFMIndex<Index>::sample_rate() const {
+  return sample_rate_;
+}
+
+template class BasicFMIndex<int>;
+template class BasicFMIndex<Index40>;
+template class BasicFMIndex<std::int64_t>;
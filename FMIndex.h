@@ -0,0 +1,111 @@
+#ifndef FMINDEX_H
+#define FMINDEX_H
+
+#pragma once
+#include "PackedIndex.h"
+#include "WaveletMatrix.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Clase BasicFMIndex - Índice comprimido sobre la transformada de
+// Burrows-Wheeler (Ferragina y Manzini 2000)
+//
+// Alternativa al Suffix Array cuando la memoria es el límite: no guarda el
+// texto ni el arreglo completo, solo
+// - la BWT en una wavelet matrix (rank por símbolo en O(1))
+// - el arreglo C (filas que empiezan con cada símbolo)
+// - una muestra del Suffix Array cada sample_rate posiciones del texto
+// Se construye a partir de build_sa, así que usa el mismo orden de sufijos
+// que BasicSuffixArray y las mismas filas [lo, hi) para cada patrón.
+// Complejidades:
+// - Construcción: la de SA-IS más O(n) para la BWT
+// - count / equal_range: O(m), búsqueda hacia atrás sin tocar el texto
+// - locate: O(m + occ · sample_rate + occ log occ)
+// - Espacio: ~1.125n bytes para la BWT más (4/sample_rate)n para la muestra
+//   con índices de 32 bits, frente a 4n + n del Suffix Array con su texto
+template <typename Index = int> class BasicFMIndex {
+public:
+  using index_type = Index;
+  using value_type = typename IndexTraits<Index>::value_type;
+
+  // Construye el índice de un texto (el texto no se conserva)
+  // sample_rate: cada cuántas posiciones del texto se guarda su entrada del
+  // Suffix Array; más grande ahorra memoria y hace locate más lento.
+  // Lanza std::invalid_argument si sample_rate es 0 y std::length_error si
+  // el texto no cabe en Index.
+  explicit BasicFMIndex(std::string_view text, unsigned sample_rate = 32);
+
+  // Igual que el anterior, reutilizando un arreglo de sufijos ya construido
+  // (por ejemplo, BasicSuffixArray::sa())
+  BasicFMIndex(std::string_view text, std::span<const Index> sa,
+               unsigned sample_rate = 32);
+
+  // Obtiene el tamaño del texto indexado
+  std::size_t n() const;
+
+  // Indica si el patrón aparece en el texto
+  // Complejidad: O(m)
+  bool search(std::string_view pattern) const;
+
+  // Rango [lo, hi) del Suffix Array con los sufijos que empiezan con el
+  // patrón, igual al de BasicSuffixArray::equal_range cuando hay
+  // ocurrencias (si no las hay devuelve un rango vacío cualquiera)
+  // Complejidad: O(m)
+  std::pair<std::size_t, std::size_t>
+  equal_range(std::string_view pattern) const;
+
+  // Número de ocurrencias del patrón
+  // Complejidad: O(m)
+  std::size_t count(std::string_view pattern) const;
+
+  // Posiciones de todas las ocurrencias en orden creciente
+  // Complejidad: O(m + occ · sample_rate + occ log occ)
+  std::vector<value_type> locate(std::string_view pattern) const;
+
+  // Memoria ocupada por el índice en bytes
+  std::size_t memory_bytes() const;
+
+  unsigned sample_rate() const;
+
+private:
+  std::size_t n_ = 0;
+  unsigned sample_rate_ = 0;
+
+  // Filas de la matriz BWT: la fila 0 es el sufijo vacío (terminador) y la
+  // fila r + 1 corresponde a sa[r]
+  WaveletMatrix bwt_;
+  std::size_t terminator_row_ = 0; // Fila cuyo carácter BWT es el terminador
+  // c_[c] = filas cuyo sufijo empieza con un símbolo menor que c, contando
+  // la del terminador
+  std::array<std::size_t, 257> c_{};
+
+  RankBitVector sampled_;      // Filas con entrada guardada en samples_
+  std::vector<Index> samples_; // Posiciones de esas filas, en orden de fila
+
+  void build(std::string_view text, std::span<const Index> sa,
+             unsigned sample_rate);
+
+  // Apariciones de c en la BWT antes de la fila row, sin el terminador
+  std::size_t occ(unsigned char c, std::size_t row) const;
+
+  // Posición en el texto del sufijo de la fila row: retrocede con LF hasta
+  // una fila muestreada
+  value_type locate_row(std::size_t row) const;
+};
+
+// Instancias compiladas en FMIndex.cpp
+extern template class BasicFMIndex<int>;
+extern template class BasicFMIndex<Index40>;
+extern template class BasicFMIndex<std::int64_t>;
+
+// Alias por ancho de índice, igual que SuffixArray
+using FMIndex = BasicFMIndex<int>;
+using FMIndex40 = BasicFMIndex<Index40>;
+using FMIndex64 = BasicFMIndex<std::int64_t>;
+
+#endif // FMINDEX_H
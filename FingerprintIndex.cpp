@@ -0,0 +1,147 @@
+#include "FingerprintIndex.h"
+#include <algorithm>
+#include <deque>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+// Base del hash polinomial módulo 2^64 (impar, para que sea invertible)
+constexpr std::uint64_t kBase = 0x100000001b3ULL;
+
+// Mezcla final (splitmix64): el hash polinomial de k-gramas parecidos es
+// parecido, y el mínimo de cada ventana debe ser una elección pseudoaleatoria
+std::uint64_t mix(std::uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+} // namespace
+
+FingerprintIndex::FingerprintIndex(int k, int window)
+    : k_(k), window_(window) {
+  if (k <= 0 || window <= 0)
+    throw std::invalid_argument(
+        "FingerprintIndex: k y window deben ser positivos");
+}
+
+// Winnowing con una cola monótona: la cola guarda los hashes de la ventana
+// que todavía pueden ser mínimos, en orden creciente, así que el frente es
+// el mínimo de la ventana. Ante empates gana el de más a la derecha. Un
+// texto con menos de window k-gramas forma una sola ventana.
+std::vector<std::uint64_t>
+FingerprintIndex::fingerprints(std::string_view text, int k, int window) {
+  std::vector<std::uint64_t> selected;
+  std::size_t length = static_cast<std::size_t>(k);
+  std::size_t w = static_cast<std::size_t>(window);
+  if (k <= 0 || window <= 0 || text.size() < length)
+    return selected;
+
+  // kBase^k, para quitar el carácter que sale del k-grama
+  std::uint64_t outgoing = 1;
+  for (std::size_t i = 0; i < length; ++i)
+    outgoing *= kBase;
+
+  std::deque<std::pair<std::uint64_t, std::size_t>> window_min;
+  std::size_t last = static_cast<std::size_t>(-1); // Última posición elegida
+  std::uint64_t rolling = 0;
+  for (std::size_t i = 0; i < text.size(); ++i) {
+    rolling = rolling * kBase + static_cast<unsigned char>(text[i]);
+    if (i >= length)
+      rolling -= outgoing * static_cast<unsigned char>(text[i - length]);
+    if (i + 1 < length)
+      continue;
+
+    // Hash del k-grama que empieza en gram
+    std::size_t gram = i + 1 - length;
+    std::uint64_t hash = mix(rolling);
+    while (!window_min.empty() && window_min.back().first >= hash)
+      window_min.pop_back();
+    window_min.emplace_back(hash, gram);
+    if (window_min.front().second + w <= gram)
+      window_min.pop_front();
+
+    // La ventana [gram - w + 1, gram] está completa: se elige su mínimo
+    if (gram + 1 >= w && window_min.front().second != last) {
+      last = window_min.front().second;
+      selected.push_back(window_min.front().first);
+    }
+  }
+  if (selected.empty())
+    selected.push_back(window_min.front().first);
+
+  std::sort(selected.begin(), selected.end());
+  selected.erase(std::unique(selected.begin(), selected.end()),
+                 selected.end());
+  return selected;
+}
+
+int FingerprintIndex::add(std::string_view document) {
+  int id = static_cast<int>(documents_++);
+  for (std::uint64_t fingerprint : fingerprints(document, k_, window_))
+    postings_[fingerprint].push_back(id);
+  return id;
+}
+
+// Recorre las listas de las huellas de la consulta contando coincidencias
+// por documento
+std::vector<FingerprintIndex::Candidate>
+FingerprintIndex::candidates(std::string_view query,
+                             std::size_t min_shared) const {
+  std::unordered_map<int, std::size_t> shared;
+  for (std::uint64_t fingerprint : fingerprints(query, k_, window_)) {
+    auto it = postings_.find(fingerprint);
+    if (it == postings_.end())
+      continue;
+    for (int document : it->second)
+      shared[document]++;
+  }
+
+  std::vector<Candidate> result;
+  for (const auto &[document, count] : shared)
+    if (count >= min_shared)
+      result.push_back({document, count});
+  std::sort(result.begin(), result.end(),
+            [](const Candidate &a, const Candidate &b) {
+              if (a.shared != b.shared)
+                return a.shared > b.shared;
+              return a.document < b.document;
+            });
+  return result;
+}
+
+// Cada lista aporta una huella común a todos sus pares de documentos
+std::vector<FingerprintIndex::CandidatePair>
+FingerprintIndex::candidate_pairs(std::size_t min_shared,
+                                  std::size_t max_postings) const {
+  std::unordered_map<std::uint64_t, std::size_t> shared;
+  for (const auto &[fingerprint, documents] : postings_) {
+    if (max_postings != 0 && documents.size() > max_postings)
+      continue;
+    for (std::size_t a = 0; a < documents.size(); ++a)
+      for (std::size_t b = a + 1; b < documents.size(); ++b)
+        shared[static_cast<std::uint64_t>(documents[a]) << 32 |
+               static_cast<std::uint32_t>(documents[b])]++;
+  }
+
+  std::vector<CandidatePair> result;
+  for (const auto &[key, count] : shared)
+    if (count >= min_shared)
+      result.push_back({static_cast<int>(key >> 32),
+                        static_cast<int>(key & 0xffffffffULL), count});
+  std::sort(result.begin(), result.end(),
+            [](const CandidatePair &a, const CandidatePair &b) {
+              if (a.first != b.first)
+                return a.first < b.first;
+              return a.second < b.second;
+            });
+  return result;
+}
+
+int FingerprintIndex::guaranteed_length() const { return k_ + window_ - 1; }
+
+std::size_t FingerprintIndex::document_count() const { return documents_; }
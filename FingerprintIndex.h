@@ -0,0 +1,82 @@
+#ifndef FINGERPRINTINDEX_H
+#define FINGERPRINTINDEX_H
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Clase FingerprintIndex - Filtro rápido de pares candidatos a plagio
+//
+// Construir un PlagiarismDetector cuesta un Suffix Array por par, aunque la
+// mayoría de los pares no tengan nada en común. Este índice descarta esos
+// pares antes del análisis exacto usando huellas por winnowing (Schleimer,
+// Wilkerson y Aiken 2003):
+// 1. Se calcula un hash rodante de cada k-grama del documento
+// 2. De cada ventana de window hashes consecutivos se elige el mínimo; los
+//    elegidos (sin repetir) son las huellas del documento
+// 3. Un índice invertido guarda, para cada huella, los documentos que la
+//    tienen; dos documentos son candidatos si comparten huellas
+// Garantía: todo fragmento común de al menos k + window - 1 caracteres
+// produce una huella común, así que esos pares nunca se descartan. Los
+// fragmentos más cortos pueden perderse.
+class FingerprintIndex {
+public:
+  // Documento del índice que comparte huellas con una consulta
+  struct Candidate {
+    int document;       // Índice del documento
+    std::size_t shared; // Huellas en común
+  };
+
+  // Par de documentos del índice que comparten huellas (first < second)
+  struct CandidatePair {
+    int first;
+    int second;
+    std::size_t shared; // Huellas en común
+  };
+
+  // Constructor
+  // k: longitud de los k-gramas (por defecto 12)
+  // window: hashes por ventana de winnowing (por defecto 8)
+  // Lanza std::invalid_argument si k o window no son positivos
+  explicit FingerprintIndex(int k = 12, int window = 8);
+
+  // Huellas de un texto, ordenadas y sin repetir
+  // Complejidad: O(n)
+  static std::vector<std::uint64_t> fingerprints(std::string_view text, int k,
+                                                 int window);
+
+  // Agrega un documento al índice y devuelve su número (0, 1, 2, ...)
+  // Complejidad: O(n) esperado
+  int add(std::string_view document);
+
+  // Documentos que comparten al menos min_shared huellas con la consulta,
+  // de más a menos huellas en común
+  // Complejidad: O(n + suma de las listas de las huellas de la consulta)
+  std::vector<Candidate> candidates(std::string_view query,
+                                    std::size_t min_shared = 1) const;
+
+  // Pares de documentos del índice que comparten al menos min_shared
+  // huellas. Las huellas presentes en más de max_postings documentos
+  // (plantillas, texto repetido en todo el corpus) se ignoran; 0 = sin
+  // límite.
+  // Complejidad: suma, sobre cada huella, del cuadrado de su lista
+  std::vector<CandidatePair> candidate_pairs(std::size_t min_shared = 1,
+                                             std::size_t max_postings = 0) const;
+
+  // Longitud mínima de un fragmento común que siempre se detecta
+  int guaranteed_length() const;
+
+  std::size_t document_count() const;
+
+private:
+  int k_;
+  int window_;
+  std::size_t documents_ = 0;
+  // Índice invertido: huella -> documentos que la tienen, en orden creciente
+  std::unordered_map<std::uint64_t, std::vector<int>> postings_;
+};
+
+#endif // FINGERPRINTINDEX_H
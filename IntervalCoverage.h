@@ -0,0 +1,46 @@
+#ifndef INTERVALCOVERAGE_H
+#define INTERVALCOVERAGE_H
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// IntervalCoverage - Posiciones de un texto cubiertas por intervalos
+//
+// Arreglo de diferencias: add() suma 1 al inicio del intervalo y resta 1 al
+// final, en O(1) sin importar su longitud; covered() acumula una sola vez.
+// Marcar carácter por carácter cuesta la suma de las longitudes, que con
+// coincidencias solapadas (documentos casi idénticos) crece como n².
+// Complejidad: O(1) por intervalo, O(n) para contar
+class IntervalCoverage {
+public:
+  explicit IntervalCoverage(std::size_t n) : diff_(n + 1, 0) {}
+
+  // Cubre [begin, end), recortado al tamaño del texto
+  void add(std::size_t begin, std::size_t end) {
+    std::size_t n = diff_.size() - 1;
+    end = std::min(end, n);
+    if (begin >= end)
+      return;
+    diff_[begin]++;
+    diff_[end]--;
+  }
+
+  // Número de posiciones cubiertas por al menos un intervalo
+  std::size_t covered() const {
+    std::size_t count = 0;
+    std::int64_t depth = 0;
+    for (std::size_t i = 0; i + 1 < diff_.size(); ++i) {
+      depth += diff_[i];
+      count += depth > 0;
+    }
+    return count;
+  }
+
+private:
+  std::vector<std::int32_t> diff_;
+};
+
+#endif // INTERVALCOVERAGE_H
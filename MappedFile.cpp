@@ -0,0 +1,66 @@
+#include "MappedFile.h"
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+// Sin mmap POSIX: se lee el archivo completo
+MappedFile::MappedFile(const std::string &path) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file)
+    throw std::runtime_error("MappedFile: no se pudo abrir " + path);
+  buffer_.resize(static_cast<std::size_t>(file.tellg()));
+  file.seekg(0);
+  file.read(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+}
+
+MappedFile::~MappedFile() = default;
+
+#else
+
+// Mapea el archivo en modo compartido y de solo lectura. El descriptor se
+// cierra de inmediato: el mapeo sigue siendo válido hasta munmap.
+MappedFile::MappedFile(const std::string &path) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw std::runtime_error("MappedFile: no se pudo abrir " + path);
+
+  struct stat info;
+  if (::fstat(fd, &info) != 0) {
+    ::close(fd);
+    throw std::runtime_error("MappedFile: no se pudo leer el tamaño de " +
+                             path);
+  }
+  size_ = static_cast<std::size_t>(info.st_size);
+
+  if (size_ > 0) {
+    void *address = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED) {
+      ::close(fd);
+      throw std::runtime_error("MappedFile: mmap falló para " + path);
+    }
+    data_ = static_cast<const char *>(address);
+  }
+  ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+  if (data_ && size_ > 0)
+    ::munmap(const_cast<char *>(data_), size_);
+}
+
+#endif
+
+const char *MappedFile::data() const { return data_; }
+
+std::size_t MappedFile::size() const { return size_; }
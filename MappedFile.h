@@ -0,0 +1,32 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Clase MappedFile - Archivo de solo lectura mapeado en memoria
+//
+// Con mmap el contenido no se copia: las páginas se cargan bajo demanda desde
+// la caché del sistema operativo y varios procesos que abren el mismo archivo
+// comparten esas páginas. En Windows se lee el archivo completo a memoria.
+class MappedFile {
+public:
+  // Mapea el archivo completo. Lanza std::runtime_error si no puede abrirse.
+  explicit MappedFile(const std::string &path);
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  const char *data() const;
+  std::size_t size() const;
+
+private:
+  const char *data_ = nullptr;
+  std::size_t size_ = 0;
+  std::vector<char> buffer_; // Solo se usa si no hay mmap
+};
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,192 @@
+#include "MatchingStatistics.h"
+#include <algorithm>
+
+// Construye el árbol de mínimos de abajo hacia arriba sobre el LCP del
+// Suffix Array
+template <typename Index>
+BasicMatchingStatistics<Index>::BasicMatchingStatistics(
+    const BasicSuffixArray<Index> &sa)
+    : sa_(&sa), lcp_(sa.lcp()), inverse_(sa.inverse_sa()) {
+  while (leaves_ < lcp_.size())
+    leaves_ *= 2;
+  tree_.resize(leaves_);
+  for (std::size_t node = leaves_ - 1; node >= 1; --node)
+    tree_[node] = std::min(node_min(2 * node), node_min(2 * node + 1));
+}
+
+template <typename Index>
+typename BasicMatchingStatistics<Index>::value_type
+BasicMatchingStatistics<Index>::node_min(std::size_t node) const {
+  if (node < leaves_)
+    return tree_[node];
+  std::size_t row = node - leaves_;
+  return row < lcp_.size() ? static_cast<value_type>(lcp_[row]) : 0;
+}
+
+// Sube desde la hoja hasta encontrar un hermano izquierdo con mínimo < t y
+// baja por él prefiriendo el hijo derecho
+// Complejidad: O(log n)
+template <typename Index>
+std::size_t BasicMatchingStatistics<Index>::previous_less(std::size_t row,
+                                                          value_type t) const {
+  std::size_t node = row + leaves_;
+  if (node_min(node) < t)
+    return row;
+  while (node > 1 && !((node & 1) && node_min(node - 1) < t))
+    node >>= 1;
+  if (node == 1)
+    return 0;
+  node -= 1;
+  while (node < leaves_)
+    node = node_min(2 * node + 1) < t ? 2 * node + 1 : 2 * node;
+  return node - leaves_;
+}
+
+// Simétrica de previous_less: busca un hermano derecho y baja prefiriendo el
+// hijo izquierdo. El relleno (lcp = 0) detrás de la última fila hace de
+// centinela.
+// Complejidad: O(log n)
+template <typename Index>
+std::size_t BasicMatchingStatistics<Index>::next_less(std::size_t row,
+                                                      value_type t) const {
+  std::size_t n = lcp_.size();
+  if (row >= n)
+    return n;
+  std::size_t node = row + leaves_;
+  if (node_min(node) < t)
+    return row;
+  while (node > 1 && !(!(node & 1) && node_min(node + 1) < t))
+    node >>= 1;
+  if (node == 1)
+    return n;
+  node += 1;
+  while (node < leaves_)
+    node = node_min(2 * node) < t ? 2 * node : 2 * node + 1;
+  return std::min(node - leaves_, n);
+}
+
+// Recorrido de las posiciones [begin, end) con el intervalo [lo, hi) de
+// query[i..i+length)
+template <typename Index>
+void BasicMatchingStatistics<Index>::compute_range(std::string_view query,
+                                                   std::size_t begin,
+                                                   std::size_t end,
+                                                   Result &result) const {
+  std::string_view text = sa_->text();
+  std::span<const Index> sa = sa_->sa();
+  std::size_t n = text.size();
+  std::size_t length = 0, lo = 0, hi = n;
+
+  // Carácter en la columna depth de la fila row; -1 si el sufijo es más
+  // corto (esos sufijos van primero dentro del bloque)
+  auto column = [&](std::size_t row, std::size_t depth) {
+    std::size_t position = static_cast<std::size_t>(sa[row]) + depth;
+    return position < n ? static_cast<int>(
+                              static_cast<unsigned char>(text[position]))
+                        : -1;
+  };
+
+  for (std::size_t i = begin; i < end; ++i) {
+    // Enlace de sufijo: de query[i-1..i-1+length) a query[i..i-1+length)
+    if (i > begin && length > 0) {
+      length--;
+      if (length == 0) {
+        lo = 0;
+        hi = n;
+      } else {
+        // El sufijo de la fila lo tiene al menos length + 1 caracteres, así
+        // que el siguiente existe
+        std::size_t row = static_cast<std::size_t>(
+            inverse_[static_cast<std::size_t>(sa[lo]) + 1]);
+        value_type depth = static_cast<value_type>(length);
+        lo = previous_less(row, depth);
+        hi = next_less(row + 1, depth);
+      }
+    }
+
+    // Extensión: dentro de [lo, hi) las filas están ordenadas por su
+    // carácter en la columna length
+    while (i + length < query.size() && lo < hi) {
+      int c = static_cast<unsigned char>(query[i + length]);
+      std::size_t first = lo, last = hi;
+      while (first < last) {
+        std::size_t middle = first + (last - first) / 2;
+        if (column(middle, length) < c)
+          first = middle + 1;
+        else
+          last = middle;
+      }
+      std::size_t stop = first, limit = hi;
+      while (stop < limit) {
+        std::size_t middle = stop + (limit - stop) / 2;
+        if (column(middle, length) <= c)
+          stop = middle + 1;
+        else
+          limit = middle;
+      }
+      if (first == stop)
+        break;
+      lo = first;
+      hi = stop;
+      length++;
+    }
+
+    result.lengths[i] = length;
+    result.intervals[i] = {lo, hi};
+  }
+}
+
+template <typename Index>
+typename BasicMatchingStatistics<Index>::Result
+BasicMatchingStatistics<Index>::compute(std::string_view query) const {
+  Result result;
+  result.lengths.resize(query.size());
+  result.intervals.resize(query.size());
+  compute_range(query, 0, query.size(), result);
+  return result;
+}
+
+template <typename Index>
+typename BasicMatchingStatistics<Index>::Result
+BasicMatchingStatistics<Index>::compute_parallel(std::string_view query,
+                                                 unsigned threads) const {
+  ThreadPool pool(threads);
+  return compute_parallel(query, pool);
+}
+
+// Bloques contiguos de la consulta, varios por hilo para repartir la carga;
+// cada uno escribe solo sus posiciones del resultado
+template <typename Index>
+typename BasicMatchingStatistics<Index>::Result
+BasicMatchingStatistics<Index>::compute_parallel(std::string_view query,
+                                                 ThreadPool &pool) const {
+  Result result;
+  result.lengths.resize(query.size());
+  result.intervals.resize(query.size());
+  std::size_t q = query.size();
+  std::size_t tasks = std::min<std::size_t>(q, pool.size() * 4);
+  pool.parallel_for(tasks, [&](std::size_t t) {
+    compute_range(query, q * t / tasks, q * (t + 1) / tasks, result);
+  });
+  return result;
+}
+
+template <typename Index>
+std::pair<std::size_t, std::size_t>
+BasicMatchingStatistics<Index>::prefix_interval(
+    std::pair<std::size_t, std::size_t> interval, std::size_t length) const {
+  if (length == 0)
+    return {0, lcp_.size()};
+  value_type depth = static_cast<value_type>(length);
+  return {previous_less(interval.first, depth),
+          next_less(interval.second, depth)};
+}
+
+template <typename Index>
+std::size_t BasicMatchingStatistics<Index>::memory_bytes() const {
+  return tree_.size() * sizeof(Index);
+}
+
+template class BasicMatchingStatistics<int>;
+template class BasicMatchingStatistics<Index40>;
+template class BasicMatchingStatistics<std::int64_t>;
@@ -0,0 +1,110 @@
+#ifndef MATCHINGSTATISTICS_H
+#define MATCHINGSTATISTICS_H
+
+#pragma once
+#include "SuffixArray.h"
+#include "ThreadPool.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Clase BasicMatchingStatistics - Coincidencia más larga de cada posición de
+// una consulta contra un texto indexado
+//
+// Para cada posición i de la consulta calcula ms[i], la longitud del prefijo
+// más largo de query[i..] que aparece en el texto, y las filas [lo, hi) del
+// Suffix Array donde aparece. Sustituye a construir un Suffix Array
+// combinado del texto y la consulta (como hace PlagiarismDetector).
+//
+// Funcionamiento (sobre un BasicSuffixArray ya construido):
+// 1. Se parte del intervalo de query[i..i+ms[i]) y se extiende carácter a
+//    carácter, acotando el rango con búsqueda binaria en la columna ms[i]
+// 2. Para pasar a i + 1 se quita el primer carácter: el sufijo siguiente de
+//    una fila se obtiene con el arreglo inverso (enlace de sufijo) y el
+//    intervalo de query[i+1..i+ms[i]) se recupera ampliándolo mientras el
+//    LCP sea >= ms[i] - 1, con un árbol de mínimos sobre el LCP
+// Como ms[i+1] >= ms[i] - 1, la consulta se recorre una sola vez.
+// Complejidad: O(q log n) para una consulta de q caracteres
+// Memoria: el LCP y el arreglo inverso del Suffix Array (en caché en él) más
+// un árbol de hasta 2n índices
+template <typename Index = int> class BasicMatchingStatistics {
+public:
+  using index_type = Index;
+  using value_type = typename IndexTraits<Index>::value_type;
+
+  // Estadísticas de una consulta, una entrada por posición
+  struct Result {
+    std::vector<std::size_t> lengths; // ms[i]
+    // Filas [lo, hi) de sa() cuyos sufijos empiezan con query[i..i+ms[i])
+    // (todo el arreglo si ms[i] = 0)
+    std::vector<std::pair<std::size_t, std::size_t>> intervals;
+  };
+
+  // Prepara el motor sobre un Suffix Array: calcula (o reutiliza) su LCP y
+  // su arreglo inverso y construye el árbol de mínimos. El Suffix Array debe
+  // seguir vivo mientras se use el objeto.
+  // Complejidad: O(n)
+  explicit BasicMatchingStatistics(const BasicSuffixArray<Index> &sa);
+
+  // Calcula las estadísticas de toda la consulta
+  // Complejidad: O(q log n)
+  Result compute(std::string_view query) const;
+
+  // Igual que compute, repartiendo la consulta en bloques entre hilos. Cada
+  // bloque empieza de cero, así que solo repite el emparejamiento de su
+  // primera posición. threads = 0 usa todos los núcleos disponibles.
+  Result compute_parallel(std::string_view query, unsigned threads = 0) const;
+
+  // Igual que la anterior, reutilizando un pool de hilos existente
+  Result compute_parallel(std::string_view query, ThreadPool &pool) const;
+
+  // Filas de los sufijos que empiezan con los primeros length caracteres de
+  // un intervalo de compute() (length <= ms[i]): el mismo rango ampliado
+  // mientras el LCP sea >= length
+  // Complejidad: O(log n)
+  std::pair<std::size_t, std::size_t>
+  prefix_interval(std::pair<std::size_t, std::size_t> interval,
+                  std::size_t length) const;
+
+  // Memoria del árbol de mínimos en bytes (el LCP y el inverso pertenecen al
+  // Suffix Array)
+  std::size_t memory_bytes() const;
+
+private:
+  const BasicSuffixArray<Index> *sa_;
+  std::span<const Index> lcp_;
+  std::span<const Index> inverse_;
+  // Árbol de mínimos del LCP: hojas implícitas (lcp_, con 0 como relleno) y
+  // nodos internos 1..leaves_-1 en tree_
+  std::size_t leaves_ = 1;
+  std::vector<Index> tree_;
+
+  // Mínimo del nodo (interno o de hoja)
+  value_type node_min(std::size_t node) const;
+
+  // Última fila p <= row con lcp[p] < t (lcp[0] = 0, así que existe si t > 0)
+  std::size_t previous_less(std::size_t row, value_type t) const;
+
+  // Primera fila p >= row con lcp[p] < t, o n si no hay
+  std::size_t next_less(std::size_t row, value_type t) const;
+
+  // Calcula las posiciones [begin, end) de la consulta en result, empezando
+  // en begin sin nada emparejado
+  void compute_range(std::string_view query, std::size_t begin,
+                     std::size_t end, Result &result) const;
+};
+
+// Instancias compiladas en MatchingStatistics.cpp
+extern template class BasicMatchingStatistics<int>;
+extern template class BasicMatchingStatistics<Index40>;
+extern template class BasicMatchingStatistics<std::int64_t>;
+
+// Alias por ancho de índice, igual que SuffixArray
+using MatchingStatistics = BasicMatchingStatistics<int>;
+using MatchingStatistics40 = BasicMatchingStatistics<Index40>;
+using MatchingStatistics64 = BasicMatchingStatistics<std::int64_t>;
+
+#endif // MATCHINGSTATISTICS_H
@@ -0,0 +1,232 @@
+#include "MultiDocumentDetector.h"
+#include "SuffixArray.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+
+// Resumen de las filas de un intervalo LCP durante el recorrido:
+// - mixed: hay filas de al menos dos documentos
+// - diverse: los caracteres anteriores no son todos iguales (o alguna fila
+//   empieza un documento), es decir, el fragmento no se extiende a la
+//   izquierda en todas sus apariciones
+struct IntervalInfo {
+  int document = -1; // Documento de la primera fila (-1 = sin filas)
+  int previous = -1; // Carácter anterior de la primera fila
+  bool mixed = false;
+  bool diverse = false;
+
+  void merge(const IntervalInfo &other) {
+    if (other.document < 0)
+      return;
+    if (document < 0) {
+      *this = other;
+      return;
+    }
+    mixed = mixed || other.mixed || document != other.document;
+    diverse = diverse || other.diverse || previous != other.previous;
+  }
+};
+
+struct OpenInterval {
+  int lcp;
+  std::size_t begin;
+  IntervalInfo info;
+};
+
+} // namespace
+
+// Constructor: une los documentos y construye SA, LCP y documento por fila
+MultiDocumentDetector::MultiDocumentDetector(
+    const std::vector<std::string> &documents, int min_match_length)
+    : min_match_length_(std::max(min_match_length, 1)) {
+  std::uint32_t count = static_cast<std::uint32_t>(documents.size());
+  std::size_t total = 0;
+  for (const auto &document : documents)
+    total += document.size() + 1;
+
+  // Separador del documento d = símbolo d; byte b = símbolo count + b
+  text_.reserve(total);
+  std::vector<std::uint32_t> symbols;
+  symbols.reserve(total);
+  for (std::uint32_t d = 0; d < count; ++d) {
+    starts_.push_back(text_.size());
+    text_ += documents[d];
+    text_ += '\0';
+    for (unsigned char c : documents[d])
+      symbols.push_back(count + c);
+    symbols.push_back(d);
+  }
+  starts_.push_back(text_.size());
+
+  sa_ = SuffixArray::build_sa_sais(symbols, count + 255);
+  lcp_ = SuffixArray::build_lcp(symbols, sa_);
+
+  doc_.resize(sa_.size());
+  std::vector<int> document_of(text_.size());
+  for (std::uint32_t d = 0; d < count; ++d)
+    std::fill(document_of.begin() + starts_[d],
+              document_of.begin() + starts_[d + 1], static_cast<int>(d));
+  for (std::size_t r = 0; r < sa_.size(); ++r)
+    doc_[r] = document_of[sa_[r]];
+}
+
+// Análisis en dos fases:
+// 1. Recorrido del LCP. Un bloque es un tramo máximo de filas con LCP >= L
+//    entre filas consecutivas: todas comparten la ventana de L caracteres
+//    que empieza en cada una. Para cada bloque con dos o más documentos se
+//    guarda la lista de documentos y, para cada posición del bloque, a qué
+//    bloque pertenece. En el mismo recorrido, una pila de intervalos LCP
+//    (Abouelhoda, Kurtz y Ohlebusch) reporta los fragmentos compartidos.
+// 2. Una posición de i está cubierta respecto de j si alguna ventana de L
+//    caracteres que la contiene aparece en j. Recorriendo i en orden de
+//    texto, las ventanas llegan ordenadas y basta recordar, para cada j,
+//    hasta dónde ya se contó.
+MultiDocumentDetector::Report MultiDocumentDetector::analyze() const {
+  std::size_t count = document_count();
+  std::size_t n = sa_.size();
+  int min_length = min_match_length_;
+
+  Report report;
+  report.covered.assign(count, std::vector<std::size_t>(count, 0));
+  report.similarity.assign(count, std::vector<double>(count, 0.0));
+
+  std::vector<int> block_of(n, -1);          // Bloque de cada posición
+  std::vector<std::size_t> block_offsets{0}; // Documentos de cada bloque en
+  std::vector<int> block_documents;          // block_documents[offsets...]
+  std::vector<std::size_t> stamp(count, n);  // Último bloque que vio a d
+  std::size_t block_begin = 0;
+
+  auto leaf = [&](std::size_t row) {
+    IntervalInfo info;
+    info.document = doc_[row];
+    std::size_t pos = sa_[row];
+    if (pos == starts_[info.document])
+      info.diverse = true; // Empieza el documento: no se extiende a la izq.
+    else
+      info.previous = static_cast<unsigned char>(text_[pos - 1]);
+    return info;
+  };
+
+  std::vector<OpenInterval> stack{{0, 0, {}}};
+  for (std::size_t i = 1; i <= n; ++i) {
+    int current = i < n ? lcp_[i] : 0;
+
+    // Cierra el bloque [block_begin, i) si el LCP baja de L
+    if (current < min_length) {
+      std::size_t first = block_documents.size();
+      for (std::size_t r = block_begin; r < i; ++r) {
+        if (stamp[doc_[r]] != block_begin) {
+          stamp[doc_[r]] = block_begin;
+          block_documents.push_back(doc_[r]);
+        }
+      }
+      if (block_documents.size() - first >= 2) {
+        int id = static_cast<int>(block_offsets.size() - 1);
+        for (std::size_t r = block_begin; r < i; ++r)
+          block_of[sa_[r]] = id;
+        block_offsets.push_back(block_documents.size());
+      } else {
+        block_documents.resize(first);
+      }
+      block_begin = i;
+    }
+
+    // Intervalos LCP: la fila i - 1 pertenece al intervalo más profundo
+    // que la contiene, el de LCP max(lcp[i-1], lcp[i])
+    if (current > stack.back().lcp) {
+      stack.push_back({current, i - 1, leaf(i - 1)});
+      continue;
+    }
+    stack.back().info.merge(leaf(i - 1));
+    IntervalInfo pending;
+    std::size_t begin = i - 1;
+    while (current < stack.back().lcp) {
+      OpenInterval node = stack.back();
+      stack.pop_back();
+      if (node.lcp >= min_length && node.info.mixed && node.info.diverse)
+        report.fragments.push_back({node.lcp, node.begin, i});
+      begin = node.begin;
+      if (current <= stack.back().lcp)
+        stack.back().info.merge(node.info);
+      else
+        pending = node.info;
+    }
+    if (current > stack.back().lcp)
+      stack.push_back({current, begin, pending});
+  }
+
+  std::sort(report.fragments.begin(), report.fragments.end(),
+            [](const SharedFragment &a, const SharedFragment &b) {
+              if (a.length != b.length)
+                return a.length > b.length;
+              return a.sa_begin < b.sa_begin;
+            });
+
+  // Cobertura por par: until[j] = posición hasta la que el documento actual
+  // ya está cubierto respecto de j. Las posiciones son globales y crecen
+  // entre documentos, así que no hace falta reiniciarlo.
+  std::vector<std::size_t> until(count, 0);
+  for (std::size_t d = 0; d < count; ++d) {
+    for (std::size_t pos = starts_[d]; pos + 1 < starts_[d + 1]; ++pos) {
+      int block = block_of[pos];
+      if (block < 0)
+        continue;
+      std::size_t end = pos + min_length;
+      for (std::size_t k = block_offsets[block]; k < block_offsets[block + 1];
+           ++k) {
+        std::size_t other = block_documents[k];
+        if (other == d)
+          continue;
+        std::size_t from = std::max(pos, until[other]);
+        if (end > from)
+          report.covered[d][other] += end - from;
+        until[other] = end;
+      }
+    }
+  }
+
+  // Similitud: porcentaje del documento más corto presente en el otro
+  for (std::size_t a = 0; a < count; ++a) {
+    for (std::size_t b = a + 1; b < count; ++b) {
+      std::size_t shorter = document(a).size() <= document(b).size() ? a : b;
+      std::size_t other = shorter == a ? b : a;
+      std::size_t length = document(shorter).size();
+      double percentage =
+          length > 0 ? 100.0 * report.covered[shorter][other] / length : 0.0;
+      report.similarity[a][b] = report.similarity[b][a] = percentage;
+    }
+  }
+  return report;
+}
+
+// Apariciones de un fragmento ordenadas por documento y posición
+std::vector<MultiDocumentDetector::Occurrence>
+MultiDocumentDetector::occurrences(const SharedFragment &fragment) const {
+  std::vector<Occurrence> result;
+  result.reserve(fragment.sa_end - fragment.sa_begin);
+  for (std::size_t r = fragment.sa_begin; r < fragment.sa_end; ++r)
+    result.push_back(
+        {doc_[r], static_cast<int>(sa_[r] - starts_[doc_[r]])});
+  std::sort(result.begin(), result.end(),
+            [](const Occurrence &a, const Occurrence &b) {
+              return a.document != b.document ? a.document < b.document
+                                              : a.position < b.position;
+            });
+  return result;
+}
+
+std::string_view
+MultiDocumentDetector::fragment_text(const SharedFragment &fragment) const {
+  return std::string_view(text_).substr(sa_[fragment.sa_begin],
+                                        fragment.length);
+}
+
+std::size_t MultiDocumentDetector::document_count() const {
+  return starts_.size() - 1;
+}
+
+std::string_view MultiDocumentDetector::document(std::size_t i) const {
+  return std::string_view(text_).substr(starts_[i],
+                                        starts_[i + 1] - starts_[i] - 1);
+}
@@ -0,0 +1,92 @@
+#ifndef MULTIDOCUMENTDETECTOR_H
+#define MULTIDOCUMENTDETECTOR_H
+
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Clase MultiDocumentDetector - Similitud entre N documentos en una pasada
+//
+// Compara todos los pares de documentos con un único Suffix Array
+// generalizado, en lugar de construir un PlagiarismDetector por par
+// (N(N-1)/2 construcciones).
+//
+// Funcionamiento:
+// 1. Une los documentos con un separador distinto para cada uno: los
+//    separadores son los símbolos 0..N-1 y cada byte b pasa a ser N + b, así
+//    que ninguna coincidencia cruza el final de un documento
+// 2. Construye el SA (SA-IS sobre alfabeto entero), el LCP y el arreglo de
+//    documento de cada fila
+// 3. Un solo recorrido del LCP encuentra los bloques de filas con LCP >=
+//    min_match_length (ventanas de esa longitud que se repiten) y los
+//    fragmentos compartidos
+// 4. Un recorrido de cada documento en orden de texto acumula, para cada
+//    otro documento, los caracteres cubiertos por esas ventanas
+class MultiDocumentDetector {
+public:
+  // Aparición de un fragmento dentro de un documento
+  struct Occurrence {
+    int document; // Índice del documento
+    int position; // Posición dentro del documento
+  };
+
+  // Fragmento de longitud >= min_match_length presente en al menos dos
+  // documentos y maximal: no puede extenderse a la derecha ni a la izquierda
+  // en todas sus apariciones a la vez. Sus apariciones son las filas
+  // [sa_begin, sa_end) del Suffix Array generalizado (ver occurrences()).
+  struct SharedFragment {
+    int length;
+    std::size_t sa_begin;
+    std::size_t sa_end;
+  };
+
+  // Resultados del análisis
+  struct Report {
+    // covered[i][j]: caracteres del documento i que forman parte de un
+    // fragmento común con el documento j (covered[i][i] = 0)
+    std::vector<std::vector<std::size_t>> covered;
+    // similarity[i][j]: porcentaje del documento más corto del par cubierto
+    // por ventanas de min_match_length caracteres que aparecen en el otro
+    // (simétrica, 0-100). No es el valor de PlagiarismDetector, que solo
+    // cuenta pares de sufijos contiguos en su Suffix Array y pierde
+    // apariciones cuando un fragmento se repite dentro de un documento; este
+    // es siempre mayor o igual, y en corpus con texto repetido la diferencia
+    // puede ser de decenas de puntos.
+    std::vector<std::vector<double>> similarity;
+    // Fragmentos compartidos, de mayor a menor longitud
+    std::vector<SharedFragment> fragments;
+  };
+
+  // Constructor: construye el índice generalizado de los documentos
+  // min_match_length: longitud mínima de un fragmento común (por defecto 10)
+  // Lanza std::length_error si el total no cabe en índices de 32 bits
+  explicit MultiDocumentDetector(const std::vector<std::string> &documents,
+                                 int min_match_length = 10);
+
+  // Calcula la matriz de similitud y los fragmentos compartidos
+  // Complejidad: O(n + c), donde c es la suma, sobre cada posición, del
+  // número de documentos que comparten su ventana (a lo sumo n·N), más
+  // O(N²) para la matriz
+  Report analyze() const;
+
+  // Apariciones de un fragmento en todos los documentos
+  std::vector<Occurrence> occurrences(const SharedFragment &fragment) const;
+
+  // Texto de un fragmento
+  std::string_view fragment_text(const SharedFragment &fragment) const;
+
+  std::size_t document_count() const;
+  std::string_view document(std::size_t i) const;
+
+private:
+  std::string text_;               // Documentos unidos por '\0'
+  std::vector<std::size_t> starts_; // Inicio de cada documento (y el final)
+  std::vector<int> sa_;            // Suffix Array generalizado
+  std::vector<int> lcp_;           // LCP entre filas consecutivas
+  std::vector<int> doc_;           // Documento de cada fila del SA
+  int min_match_length_;
+};
+
+#endif // MULTIDOCUMENTDETECTOR_H
@@ -0,0 +1,53 @@
+#ifndef PACKEDINDEX_H
+#define PACKEDINDEX_H
+
+#pragma once
+#include <cstdint>
+#include <limits>
+
+// Index40 - Entero con signo de 40 bits empaquetado en 5 bytes
+//
+// Permite indexar textos de hasta 2^39 - 1 caracteres (~512 GB) usando 5n
+// bytes para el Suffix Array en lugar de los 8n de un índice de 64 bits.
+// No tiene aritmética propia: se convierte implícitamente a int64_t para
+// operar y desde int64_t para almacenar.
+class Index40 {
+public:
+  Index40() = default;
+  Index40(std::int64_t value) {
+    std::uint64_t bits = static_cast<std::uint64_t>(value);
+    for (int i = 0; i < 5; ++i) // Se guardan los 5 bytes menos significativos
+      bytes_[i] = static_cast<unsigned char>(bits >> (8 * i));
+  }
+
+  operator std::int64_t() const {
+    std::uint64_t bits = 0;
+    for (int i = 0; i < 5; ++i)
+      bits |= static_cast<std::uint64_t>(bytes_[i]) << (8 * i);
+    // Extensión de signo desde el bit 39
+    return static_cast<std::int64_t>(bits << 24) >> 24;
+  }
+
+  static constexpr std::int64_t max() { return (std::int64_t(1) << 39) - 1; }
+
+private:
+  unsigned char bytes_[5] = {};
+};
+
+static_assert(sizeof(Index40) == 5, "Index40 debe ocupar 5 bytes");
+
+// Tipo aritmético con el que se opera sobre un tipo de índice almacenado.
+// Para los enteros nativos es el mismo tipo; Index40 opera como int64_t.
+template <typename Index> struct IndexTraits {
+  using value_type = Index;
+  static constexpr std::int64_t max() {
+    return static_cast<std::int64_t>(std::numeric_limits<Index>::max());
+  }
+};
+
+template <> struct IndexTraits<Index40> {
+  using value_type = std::int64_t;
+  static constexpr std::int64_t max() { return Index40::max(); }
+};
+
+#endif // PACKEDINDEX_H
@@ -1,59 +1,80 @@
 #include "PlagiarismDetector.h"
+#include "IntervalCoverage.h"
 #include <algorithm>
-#include <set>
+#include <type_traits>
 
 // Constructor: prepara los textos para el análisis
-PlagiarismDetector::PlagiarismDetector(const std::string &text1,
-                                       const std::string &text2,
+PlagiarismDetector::PlagiarismDetector(std::string_view text1,
+                                       std::string_view text2,
                                        int min_match_length)
-    : text1_(text1), text2_(text2), min_match_length_(min_match_length) {
-
-  // Combinamos ambos textos con un separador especial que no aparece en ninguno
-  // Formato: text1 + '#' + text2
-  // El carácter '#' actúa como barrera para que no se encuentren coincidencias
-  // falsas
-  combined_ = text1_ + "#" + text2_;
-  separator_pos_ = static_cast<int>(text1_.size());
+    : sa_(combine(text1, text2)), min_match_length_(min_match_length) {
+  // El Suffix Array se queda con el texto combinado; los documentos son
+  // vistas sobre esa única copia, que sigue siendo válida aunque el detector
+  // se copie o se mueva
+  combined_ = sa_.text();
+  separator_pos_ = static_cast<int>(text1.size());
+  text1_ = combined_.substr(0, text1.size());
+  text2_ = combined_.substr(text1.size() + 1);
+
+  // El LCP compacto también se construye aquí, de modo que todo el estado
+  // del índice es inmutable desde el constructor y los análisis solo leen
+  sa_.compact_lcp();
+}
 
-  // Construimos el Suffix Array del texto combinado
-  sa_ = new SuffixArray(combined_);
+// Combinamos ambos textos con un separador especial que no aparece en ninguno
+// Formato: text1 + '#' + text2
+// El carácter '#' actúa como barrera para que no se encuentren coincidencias
+// falsas
+std::string PlagiarismDetector::combine(std::string_view text1,
+                                        std::string_view text2) {
+  std::string combined;
+  combined.reserve(text1.size() + 1 + text2.size());
+  combined.append(text1);
+  combined += '#';
+  combined.append(text2);
+  return combined;
 }
 
-// Análisis principal de plagio usando Suffix Array y LCP Array
+// Recorrido del LCP array compartido por todos los modos de análisis
 //
 // Algoritmo:
-// 1. Construir LCP array para encontrar prefijos comunes
+// 1. Obtener el LCP array (compacto, en caché) para encontrar prefijos comunes
 // 2. Buscar en el SA pares de sufijos que:
 //    - Provengan de documentos diferentes
 //    - Tengan LCP >= longitud mínima
-// 3. Filtrar coincidencias duplicadas
+// 3. Marcar la cobertura de cada par y entregarlo a on_match
 // 4. Calcular métricas de similitud
-PlagiarismDetector::Report PlagiarismDetector::analyze() {
+// El reporte devuelto no contiene coincidencias: qué se guarda de cada una
+// lo decide on_match. Las coincidencias llegan sin texto (lo pone
+// fill_text en las que se conservan) y con on_match = nullptr ni siquiera
+// se construyen. La memoria propia es O(n) por la cobertura.
+template <typename OnMatch>
+PlagiarismDetector::Report PlagiarismDetector::scan(OnMatch &&on_match) const {
   Report report;
   report.similarity_percentage = 0.0;
   report.total_matched_chars = 0;
   report.longest_match = 0;
 
-  // Construir el LCP array
-  std::vector<int> lcp = build_lcp_array();
+  // LCP compacto del Suffix Array (se calcula una vez y queda en caché)
+  const CompactLcp &lcp = sa_.compact_lcp();
+  std::span<const int> sa = sa_.sa();
 
-  // Set para evitar contar el mismo fragmento múltiples veces
-  std::set<std::pair<int, int>> seen_matches;
-
-  // Vectores para rastrear caracteres cubiertos y evitar conteo doble (overlap)
-  std::vector<bool> covered1(text1_.size(), false);
-  std::vector<bool> covered2(text2_.size(), false);
+  // Caracteres cubiertos de cada texto, sin contar dos veces los solapes.
+  // No hace falta descartar pares repetidos: cada par de sufijos es
+  // contiguo en el SA a lo sumo una vez.
+  IntervalCoverage covered1(text1_.size());
+  IntervalCoverage covered2(text2_.size());
 
   // Recorremos el LCP array buscando coincidencias
   for (int i = 1; i < static_cast<int>(lcp.size()); ++i) {
-    int lcp_val = lcp[i];
+    int lcp_val = static_cast<int>(lcp[i]);
 
     // Solo nos interesan coincidencias suficientemente largas
     if (lcp_val < min_match_length_)
       continue;
 
-    int pos1 = sa_->sa()[i - 1];
-    int pos2 = sa_->sa()[i];
+    int pos1 = sa[i - 1];
+    int pos2 = sa[i];
 
     // Verificar que los sufijos vengan de documentos diferentes
     if (!from_different_texts(pos1, pos2))
@@ -67,79 +88,27 @@ PlagiarismDetector::Report PlagiarismDetector::analyze() {
     // Ajustar pos2 para que sea relativo al inicio del segundo texto
     int adjusted_pos2 = pos2 - separator_pos_ - 1;
 
-    // Evitar duplicados exactos de pares de posiciones
-    auto match_key = std::make_pair(pos1, adjusted_pos2);
-    if (seen_matches.count(match_key))
-      continue;
-    seen_matches.insert(match_key);
-
     // Marcar caracteres cubiertos en ambos textos
-    for (int k = 0; k < lcp_val; ++k) {
-      if (pos1 + k < static_cast<int>(covered1.size()))
-        covered1[pos1 + k] = true;
-      if (adjusted_pos2 + k < static_cast<int>(covered2.size()))
-        covered2[adjusted_pos2 + k] = true;
+    covered1.add(pos1, pos1 + lcp_val);
+    covered2.add(adjusted_pos2, adjusted_pos2 + lcp_val);
+
+    // Crear el registro de coincidencia: solo posiciones, sin texto ni
+    // memoria por coincidencia
+    if constexpr (!std::is_null_pointer_v<std::decay_t<OnMatch>>) {
+      Match match;
+      match.pos1 = pos1;
+      match.pos2 = adjusted_pos2;
+      match.length = lcp_val;
+      on_match(match);
     }
-
-    // Crear el registro de coincidencia
-    Match match;
-    match.pos1 = pos1;
-    match.pos2 = adjusted_pos2;
-    match.length = lcp_val;
-    match.text = extract_substring(pos1, lcp_val);
-
-    report.matches.push_back(match);
     report.longest_match = std::max(report.longest_match, lcp_val);
   }
-
-  // Eliminamos coincidencias que están contenidas dentro de otras más grandes
-  // Ejemplo: Si tenemos "Hola mundo", eliminamos "ola mundo", "la mundo"
-
-  // 1. Ordenar por longitud descendente (priorizar las más largas)
-  std::sort(report.matches.begin(), report.matches.end(),
-            [](const Match &a, const Match &b) { return a.length > b.length; });
-
-  std::vector<Match> filtered_matches;
-  filtered_matches.reserve(report.matches.size());
-
-  for (const auto &candidate : report.matches) {
-    bool is_redundant = false;
-
-    // Verificar si esta coincidencia está contenida en alguna ya aceptada
-    for (const auto &existing : filtered_matches) {
-      // Verificamos contención en text1
-      bool contained_in_t1 = (candidate.pos1 >= existing.pos1) &&
-                             (candidate.pos1 + candidate.length <=
-                              existing.pos1 + existing.length);
-
-      // Verificamos contención en text2
-      bool contained_in_t2 = (candidate.pos2 >= existing.pos2) &&
-                             (candidate.pos2 + candidate.length <=
-                              existing.pos2 + existing.length);
-
-      // Verificamos que sea la "misma" coincidencia (mismo desplazamiento
-      // relativo)
-      bool same_relative_offset =
-          (candidate.pos1 - existing.pos1) == (candidate.pos2 - existing.pos2);
-
-      if (contained_in_t1 && contained_in_t2 && same_relative_offset) {
-        is_redundant = true;
-        break;
-      }
-    }
-
-    if (!is_redundant) {
-      filtered_matches.push_back(candidate);
-    }
-  }
-
-  // Reemplazamos la lista original con la filtrada
-  report.matches = filtered_matches;
+  report.source = sa_.keepalive();
 
   // Calcular total de caracteres únicos cubiertos
   // Usamos el conteo del texto más corto para el porcentaje
-  int covered_count1 = std::count(covered1.begin(), covered1.end(), true);
-  int covered_count2 = std::count(covered2.begin(), covered2.end(), true);
+  int covered_count1 = static_cast<int>(covered1.covered());
+  int covered_count2 = static_cast<int>(covered2.covered());
 
   int min_length = std::min(static_cast<int>(text1_.size()),
                             static_cast<int>(text2_.size()));
@@ -166,45 +135,136 @@ PlagiarismDetector::Report PlagiarismDetector::analyze() {
   return report;
 }
 
-// Construye el LCP Array usando el algoritmo de Kasai
-// El LCP array es fundamental para encontrar subcadenas comunes.
-// LCP[i] = longitud del prefijo común más largo entre SA[i] y SA[i-1]
-// Ejemplo:
-// Texto: "banana"
-// SA: [5, 3, 1, 0, 4, 2] → sufijos: ["a", "ana", "anana", "banana", "na",
-// "nana"] LCP: [0, 1, 3, 0, 0, 2] → prefijos comunes entre sufijos consecutivos
-// Complejidad: O(n) usando el algoritmo de Kasai
-std::vector<int> PlagiarismDetector::build_lcp_array() {
-  int n = sa_->n();
-  std::vector<int> lcp(n, 0);
-  std::vector<int> rank(n);
-
-  // Construir el array de ranking (inverso del SA)
-  // rank[i] = posición del sufijo i en el SA
-  for (int i = 0; i < n; ++i) {
-    rank[sa_->sa()[i]] = i;
-  }
+// Análisis principal de plagio usando Suffix Array y LCP Array
+// Guarda todas las coincidencias y filtra las contenidas en otras. Se calcula
+// una vez: call_once serializa las llamadas concurrentes y las demás esperan
+// al mismo resultado.
+const PlagiarismDetector::Report &PlagiarismDetector::analyze() const {
+  std::call_once(cache_->report_once, [this] {
+    std::vector<Match> matches;
+    Report report =
+        scan([&](const Match &match) { matches.push_back(match); });
+
+    // Eliminamos coincidencias que están contenidas dentro de otras más
+    // grandes. Ejemplo: Si tenemos "Hola mundo", eliminamos "ola mundo",
+    // "la mundo"
+    report.matches = remove_contained(std::move(matches));
+    for (Match &match : report.matches)
+      fill_text(match);
+    cache_->report = std::move(report);
+    cache_->report_ready.store(true, std::memory_order_release);
+  });
+  return cache_->report;
+}
 
-  // Algoritmo de Kasai para construir LCP en tiempo lineal
-  int h = 0; // Longitud del LCP actual
-  for (int i = 0; i < n; ++i) {
-    if (rank[i] > 0) {
-      int j = sa_->sa()[rank[i] - 1]; // Sufijo anterior en orden lexicográfico
+// Modo streaming: cada coincidencia maximal a la izquierda se entrega al
+// callback en cuanto aparece en el recorrido (en orden del SA, no por
+// longitud). Las vistas de Match.text solo son válidas mientras viva el
+// detector o el Report devuelto.
+PlagiarismDetector::Report PlagiarismDetector::analyze_stream(
+    const std::function<void(const Match &)> &callback) const {
+  return scan([&](const Match &match) {
+    if (!left_maximal(match))
+      return;
+    Match kept = match;
+    fill_text(kept);
+    callback(kept);
+  });
+}
 
-      // Calcular LCP entre sufijos i y j
-      while (i + h < n && j + h < n && combined_[i + h] == combined_[j + h]) {
-        h++;
-      }
+// Modo top-K: montículo de mínimos con las k mejores coincidencias vistas;
+// la peor está en la cima y se reemplaza cuando llega una más larga.
+// Memoria O(k) para las coincidencias, O(n log k) en tiempo.
+PlagiarismDetector::Report PlagiarismDetector::analyze_top(std::size_t k) const {
+  // Mismo orden que el reporte completo: longitud descendente, pos1, pos2
+  auto better = [](const Match &a, const Match &b) {
+    if (a.length != b.length)
+      return a.length > b.length;
+    if (a.pos1 != b.pos1)
+      return a.pos1 < b.pos1;
+    return a.pos2 < b.pos2;
+  };
+
+  std::vector<Match> heap;
+  heap.reserve(k);
+  Report report = scan([&](const Match &match) {
+    if (k == 0 || !left_maximal(match))
+      return;
+    if (heap.size() < k) {
+      heap.push_back(match);
+      std::push_heap(heap.begin(), heap.end(), better);
+    } else if (better(match, heap.front())) {
+      std::pop_heap(heap.begin(), heap.end(), better);
+      heap.back() = match;
+      std::push_heap(heap.begin(), heap.end(), better);
+    }
+  });
 
-      lcp[rank[i]] = h;
+  std::sort_heap(heap.begin(), heap.end(), better);
+  for (Match &match : heap)
+    fill_text(match);
+  report.matches = std::move(heap);
+  return report;
+}
 
-      // Optimización: el siguiente LCP será al menos h-1
-      if (h > 0)
-        h--;
-    }
+// Modo solo similitud: recorre el LCP y mide la cobertura sin construir
+// ninguna coincidencia
+PlagiarismDetector::Report PlagiarismDetector::analyze_similarity() const {
+  return scan(nullptr);
+}
+
+// Una coincidencia es maximal a la izquierda si no puede extenderse un
+// carácter hacia atrás en ambos textos. Ninguna otra coincidencia de su
+// diagonal puede contenerla, así que siempre sobrevive a remove_contained.
+bool PlagiarismDetector::left_maximal(const Match &match) const {
+  return match.pos1 == 0 || match.pos2 == 0 ||
+         text1_[match.pos1 - 1] != text2_[match.pos2 - 1];
+}
+
+// Filtra las coincidencias contenidas en otra del mismo desplazamiento
+// relativo (diagonal pos1 - pos2) en ambos textos
+//
+// En lugar de comparar cada candidata con todas las aceptadas (O(k²)), se
+// ordenan por (diagonal, pos1, longitud descendente): dentro de una diagonal,
+// una coincidencia está contenida en otra si y solo si alguna anterior
+// termina en o después de su final, así que basta llevar el máximo final.
+// El resultado queda ordenado por longitud descendente, luego pos1 y pos2.
+// Complejidad: O(k log k)
+std::vector<PlagiarismDetector::Match>
+PlagiarismDetector::remove_contained(std::vector<Match> matches) {
+  std::sort(matches.begin(), matches.end(),
+            [](const Match &a, const Match &b) {
+              int diagonal_a = a.pos1 - a.pos2, diagonal_b = b.pos1 - b.pos2;
+              if (diagonal_a != diagonal_b)
+                return diagonal_a < diagonal_b;
+              if (a.pos1 != b.pos1)
+                return a.pos1 < b.pos1;
+              return a.length > b.length;
+            });
+
+  std::vector<Match> filtered;
+  filtered.reserve(matches.size());
+  int max_end = 0; // Máximo final en text1 de las anteriores de la diagonal
+  for (size_t i = 0; i < matches.size(); ++i) {
+    int diagonal = matches[i].pos1 - matches[i].pos2;
+    bool same_diagonal =
+        i > 0 && matches[i - 1].pos1 - matches[i - 1].pos2 == diagonal;
+    int end = matches[i].pos1 + matches[i].length;
+    if (same_diagonal && max_end >= end)
+      continue;
+    max_end = same_diagonal ? std::max(max_end, end) : end;
+    filtered.push_back(std::move(matches[i]));
   }
 
-  return lcp;
+  std::sort(filtered.begin(), filtered.end(),
+            [](const Match &a, const Match &b) {
+              if (a.length != b.length)
+                return a.length > b.length;
+              if (a.pos1 != b.pos1)
+                return a.pos1 < b.pos1;
+              return a.pos2 < b.pos2;
+            });
+  return filtered;
 }
 
 // Verifica si dos posiciones están en documentos diferentes
@@ -214,29 +274,50 @@ bool PlagiarismDetector::from_different_texts(int pos1, int pos2) const {
          (pos2 <= separator_pos_ && pos1 > separator_pos_);
 }
 
-// Extrae una subcadena del texto combinado
-std::string PlagiarismDetector::extract_substring(int pos, int len) const {
-  // Asegurar que no extraemos el separador
-  if (pos >= static_cast<int>(combined_.size()))
-    return "";
-
-  int actual_len = std::min(len, static_cast<int>(combined_.size()) - pos);
-  std::string result = combined_.substr(pos, actual_len);
+// Vista de una subcadena del primer texto, recortada en el separador
+// Complejidad: O(1); un '#' dentro de los documentos no la recorta
+std::string_view PlagiarismDetector::extract_substring(int pos,
+                                                       int len) const {
+  if (pos >= separator_pos_)
+    return {};
+  return text1_.substr(pos, std::min(len, separator_pos_ - pos));
+}
 
-  // Eliminar el separador si está presente
-  size_t sep_pos = result.find('#');
-  if (sep_pos != std::string::npos) {
-    result = result.substr(0, sep_pos);
-  }
+// Pone en la coincidencia la vista de su texto
+void PlagiarismDetector::fill_text(Match &match) const {
+  match.text = extract_substring(match.pos1, match.length);
+}
 
-  return result;
+// Métricas en caché: si analyze() ya terminó se copian de su reporte; si no,
+// basta el recorrido sin coincidencias. Ambos caminos dan los mismos valores.
+const PlagiarismDetector::Report &PlagiarismDetector::metrics() const {
+  std::call_once(cache_->metrics_once, [this] {
+    Report metrics;
+    if (cache_->report_ready.load(std::memory_order_acquire)) {
+      const Report &report = cache_->report;
+      metrics.similarity_percentage = report.similarity_percentage;
+      metrics.total_matched_chars = report.total_matched_chars;
+      metrics.longest_match = report.longest_match;
+      metrics.source = report.source;
+    } else {
+      metrics = analyze_similarity();
+    }
+    cache_->metrics = std::move(metrics);
+  });
+  return cache_->metrics;
 }
 
 // Obtiene el porcentaje de similitud
 double PlagiarismDetector::get_similarity_percentage() const {
-  // Nota: Este método no debería ser const porque analyze() modifica estado
-  // interno Sin embargo, para mantener la interfaz const, creamos un objeto
-  // temporal
-  PlagiarismDetector temp(text1_, text2_, min_match_length_);
-  return temp.analyze().similarity_percentage;
+  return metrics().similarity_percentage;
+}
+
+// Total de caracteres cubiertos del texto más corto
+int PlagiarismDetector::get_total_matched_chars() const {
+  return metrics().total_matched_chars;
+}
+
+// Longitud del fragmento común más largo
+int PlagiarismDetector::get_longest_match() const {
+  return metrics().longest_match;
 }
@@ -3,7 +3,13 @@
 
 #pragma once
 #include "SuffixArray.h"
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -22,11 +28,13 @@
 class PlagiarismDetector {
 public:
   // Representa un fragmento de texto común entre dos documentos
+  // El texto es una vista sobre el texto combinado del detector, sin copia;
+  // sigue siendo válida mientras exista el Report que la contiene.
   struct Match {
-    int pos1;         // Posición en el primer documento
-    int pos2;         // Posición en el segundo documento
-    int length;       // Longitud del fragmento común
-    std::string text; // Texto del fragmento
+    int pos1;              // Posición en el primer documento
+    int pos2;              // Posición en el segundo documento
+    int length;            // Longitud del fragmento común
+    std::string_view text; // Texto del fragmento
   };
 
   // Resultados del análisis de plagio
@@ -35,6 +43,9 @@ public:
     std::vector<Match> matches;   // Lista de fragmentos comunes
     int total_matched_chars;      // Total de caracteres coincidentes
     int longest_match;            // Longitud del fragmento más largo
+    // Mantiene vivo el texto al que apuntan las vistas de matches, aunque
+    // el detector ya no exista
+    std::shared_ptr<const void> source;
   };
 
   // Constructor
@@ -42,35 +53,99 @@ public:
   // text2: Segundo documento a comparar
   // min_match_length: Longitud mínima para considerar un fragmento como plagio
   // (por defecto 10)
-  PlagiarismDetector(const std::string &text1, const std::string &text2,
+  // Los textos se copian una sola vez, al texto combinado que indexa el
+  // Suffix Array; text1_ y text2_ son vistas sobre él.
+  // El detector trabaja con posiciones de 32 bits: lanza std::length_error
+  // (desde el constructor de SuffixArray) si el texto combinado no cabe.
+  PlagiarismDetector(std::string_view text1, std::string_view text2,
                      int min_match_length = 10);
 
   // Ejecuta el análisis de plagio y genera un reporte
-  // Complejidad: O(n log n) para construcción + O(n) para análisis
-  Report analyze();
+  // El reporte se calcula una sola vez y queda en caché: las siguientes
+  // llamadas, también desde varios hilos a la vez, devuelven el mismo
+  // objeto. La referencia es válida mientras exista el detector.
+  // Complejidad: O(n + k log k) la primera vez, O(1) después
+  const Report &analyze() const;
+
+  // Modos de memoria acotada para documentos muy parecidos, donde la lista
+  // completa de coincidencias puede llegar a millones de entradas. Todos
+  // calculan las mismas métricas de similitud que analyze(), pero solo
+  // consideran coincidencias maximales a la izquierda (no extensibles hacia
+  // atrás), que son un subconjunto de las que conserva analyze(); la más
+  // larga siempre está entre ellas.
+
+  // Entrega cada coincidencia al callback en cuanto se encuentra, en orden
+  // del Suffix Array; el reporte devuelto no guarda ninguna
+  Report
+  analyze_stream(const std::function<void(const Match &)> &callback) const;
+
+  // Guarda solo las k coincidencias más largas, con un montículo acotado
+  // Memoria: O(k) coincidencias
+  Report analyze_top(std::size_t k) const;
+
+  // Solo calcula las métricas, sin reunir coincidencias
+  Report analyze_similarity() const;
+
+  // Métricas de similitud, en caché tras la primera consulta. Reutilizan el
+  // reporte de analyze() si ya existe; si no, lo calculan sin reunir
+  // coincidencias (como analyze_similarity()). O(1) las siguientes veces.
 
   // Obtiene el porcentaje de similitud entre los dos textos
   double get_similarity_percentage() const;
 
+  // Total de caracteres cubiertos del texto más corto
+  int get_total_matched_chars() const;
+
+  // Longitud del fragmento común más largo
+  int get_longest_match() const;
+
 private:
-  std::string text1_;    // Primer documento
-  std::string text2_;    // Segundo documento
-  std::string combined_; // Textos combinados con separador
-  int separator_pos_;    // Posición del separador en combined_
-  int min_match_length_; // Longitud mínima de coincidencia
-  SuffixArray *sa_;      // Suffix Array del texto combinado
-
-  // Construye el LCP Array (Longest Common Prefix)
-  // El LCP[i] almacena la longitud del prefijo común más largo
-  // entre los sufijos en las posiciones sa[i] y sa[i-1]
-  // Complejidad: O(n)
-  std::vector<int> build_lcp_array();
+  SuffixArray sa_;            // Suffix Array dueño del texto combinado
+  std::string_view combined_; // Textos combinados con separador
+  std::string_view text1_;    // Primer documento (vista sobre combined_)
+  std::string_view text2_;    // Segundo documento (vista sobre combined_)
+  int separator_pos_;         // Posición del separador en combined_
+  int min_match_length_;      // Longitud mínima de coincidencia
+
+  // Resultados memorizados. El Suffix Array y su LCP se construyen en el
+  // constructor y no cambian, así que el análisis es el mismo siempre; las
+  // copias del detector comparten la caché.
+  struct AnalysisCache {
+    std::once_flag report_once, metrics_once;
+    std::atomic<bool> report_ready{false};
+    Report report;  // Reporte completo de analyze()
+    Report metrics; // Solo métricas, sin coincidencias
+  };
+  std::shared_ptr<AnalysisCache> cache_ = std::make_shared<AnalysisCache>();
+
+  // Métricas en caché (ver get_similarity_percentage)
+  const Report &metrics() const;
+
+  // Une ambos textos con el separador '#'
+  static std::string combine(std::string_view text1, std::string_view text2);
+
+  // Descarta las coincidencias contenidas en otra de la misma diagonal y
+  // ordena el resto por longitud descendente
+  // Complejidad: O(k log k) para k coincidencias
+  static std::vector<Match> remove_contained(std::vector<Match> matches);
+
+  // Recorre el LCP array, mide la cobertura y pasa cada coincidencia
+  // candidata (sin texto) a on_match; base común de todos los modos de
+  // análisis. Con on_match = nullptr solo mide la cobertura.
+  template <typename OnMatch> Report scan(OnMatch &&on_match) const;
+
+  // Indica si la coincidencia no puede extenderse hacia atrás
+  bool left_maximal(const Match &match) const;
 
   // Verifica si dos posiciones pertenecen a documentos diferentes
   bool from_different_texts(int pos1, int pos2) const;
 
-  // Extrae subcadena del texto combinado
-  std::string extract_substring(int pos, int len) const;
+  // Vista de una subcadena del primer texto, cortada antes del separador
+  std::string_view extract_substring(int pos, int len) const;
+
+  // Rellena match.text; solo se llama para las coincidencias que se
+  // entregan o se guardan, no para cada candidata del recorrido
+  void fill_text(Match &match) const;
 };
 
 #endif // PLAGIARISMDETECTOR_H
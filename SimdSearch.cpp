@@ -0,0 +1,113 @@
+#include "SimdSearch.h"
+#include "SuffixCompare.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SIMDSEARCH_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Verifica una candidata cuyos extremos ya coinciden
+bool matches_inside(const char *candidate, std::string_view pattern) {
+  std::size_t m = pattern.size();
+  return m <= 2 || SuffixCompare::mismatch(candidate + 1, pattern.data() + 1,
+                                           m - 2) == m - 2;
+}
+
+// Mismo filtro por extremos, una posición a la vez. También termina las
+// colas de los núcleos SIMD.
+std::size_t find_scalar(std::string_view text, std::string_view pattern,
+                        std::size_t from) {
+  std::size_t m = pattern.size();
+  char first = pattern[0], last = pattern[m - 1];
+  for (std::size_t i = from; i + m <= text.size(); ++i)
+    if (text[i] == first && text[i + m - 1] == last &&
+        matches_inside(text.data() + i, pattern))
+      return i;
+  return std::string_view::npos;
+}
+
+#ifdef SIMDSEARCH_X86
+
+__attribute__((target("sse2"))) std::size_t
+find_sse2(std::string_view text, std::string_view pattern, std::size_t from) {
+  std::size_t m = pattern.size(), n = text.size();
+  const char *s = text.data();
+  __m128i first = _mm_set1_epi8(pattern[0]);
+  __m128i last = _mm_set1_epi8(pattern[m - 1]);
+  std::size_t i = from;
+  for (; i + m + 15 <= n; i += 16) {
+    __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+    __m128i tail =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i + m - 1));
+    unsigned candidates = static_cast<unsigned>(_mm_movemask_epi8(
+        _mm_and_si128(_mm_cmpeq_epi8(head, first), _mm_cmpeq_epi8(tail, last))));
+    while (candidates != 0) {
+      std::size_t pos = i + static_cast<std::size_t>(__builtin_ctz(candidates));
+      if (matches_inside(s + pos, pattern))
+        return pos;
+      candidates &= candidates - 1;
+    }
+  }
+  return find_scalar(text, pattern, i);
+}
+
+__attribute__((target("avx2"))) std::size_t
+find_avx2(std::string_view text, std::string_view pattern, std::size_t from) {
+  std::size_t m = pattern.size(), n = text.size();
+  const char *s = text.data();
+  __m256i first = _mm256_set1_epi8(pattern[0]);
+  __m256i last = _mm256_set1_epi8(pattern[m - 1]);
+  std::size_t i = from;
+  for (; i + m + 31 <= n; i += 32) {
+    __m256i head =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+    __m256i tail =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i + m - 1));
+    unsigned candidates = static_cast<unsigned>(
+        _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(head, first),
+                                              _mm256_cmpeq_epi8(tail, last))));
+    while (candidates != 0) {
+      std::size_t pos = i + static_cast<std::size_t>(__builtin_ctz(candidates));
+      if (matches_inside(s + pos, pattern))
+        return pos;
+      candidates &= candidates - 1;
+    }
+  }
+  return find_scalar(text, pattern, i);
+}
+
+#endif
+
+} // namespace
+
+std::size_t SimdSearch::find(std::string_view text, std::string_view pattern,
+                             std::size_t from) {
+  if (pattern.empty())
+    return from <= text.size() ? from : std::string_view::npos;
+  if (from > text.size() || pattern.size() > text.size() - from)
+    return std::string_view::npos;
+#ifdef SIMDSEARCH_X86
+  switch (SuffixCompare::kernel()) {
+  case SuffixCompare::Kernel::AVX2:
+    return find_avx2(text, pattern, from);
+  case SuffixCompare::Kernel::SSE2:
+    return find_sse2(text, pattern, from);
+  default:
+    break;
+  }
+#endif
+  return find_scalar(text, pattern, from);
+}
+
+std::vector<int> SimdSearch::search(const std::string &text,
+                                    const std::string &pattern) {
+  std::vector<int> result;
+  if (pattern.empty())
+    return result;
+  for (std::size_t pos = find(text, pattern); pos != std::string_view::npos;
+       pos = find(text, pattern, pos + 1))
+    result.push_back(static_cast<int>(pos));
+  return result;
+}
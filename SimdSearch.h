@@ -0,0 +1,37 @@
+#ifndef SIMDSEARCH_H
+#define SIMDSEARCH_H
+
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Clase SimdSearch - Búsqueda lineal de un patrón con filtro SIMD
+//
+// Para consultas únicas no vale la pena construir un índice; KMP y
+// Boyer-Moore avanzan byte a byte. Este escáner (Muła, "SIMD-friendly
+// algorithms for substring searching") compara a la vez 32 (AVX2) o 16
+// (SSE2) posiciones candidatas:
+// 1. Un bloque de texto se compara con el primer byte del patrón y el bloque
+//    desplazado m - 1 posiciones, con el último
+// 2. El AND de ambas máscaras deja solo las posiciones donde coinciden los
+//    dos extremos, que suelen ser muy pocas
+// 3. Cada candidata se verifica con SuffixCompare::mismatch
+// Usa el mismo núcleo que SuffixCompare (set_kernel cambia ambos); el
+// escalar aplica el mismo filtro posición a posición.
+// Complejidad: O(n / ancho del bloque) en texto típico, O(n m) en el peor
+// caso (muchas candidatas que fallan tarde)
+class SimdSearch {
+public:
+  // Todas las ocurrencias (incluso solapadas) en orden creciente, igual que
+  // KMP::search y BoyerMoore::search. Un patrón vacío no tiene ocurrencias.
+  static std::vector<int> search(const std::string &text,
+                                 const std::string &pattern);
+
+  // Primera ocurrencia en text[from..], o std::string_view::npos
+  static std::size_t find(std::string_view text, std::string_view pattern,
+                          std::size_t from = 0);
+};
+
+#endif // SIMDSEARCH_H
@@ -1,56 +1,384 @@
 #include "SuffixArray.h"
+#include "MappedFile.h"
+#include "SuffixCompare.h"
+#include "ThreadPool.h"
+#include "WaveletMatrix.h"
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
-// Constructor: inicializa la cadena y construye el Suffix Array
-SuffixArray::SuffixArray(const std::string &s) : s_(s) { sa_ = build_sa(s_); }
+namespace {
 
-// Devuelve el arreglo de sufijos
-const std::vector<int> &SuffixArray::sa() const { return sa_; }
+// Núcleo de SA-IS (Suffix Array by Induced Sorting, Nong-Zhang-Chan 2009)
+// Funciona sobre cualquier alfabeto entero [0, upper]: la cadena original usa
+// bytes y la llamada recursiva usa los nombres de las subcadenas LMS.
+// Clasificación de sufijos:
+// - Tipo S: sufijo menor que el siguiente; tipo L: mayor que el siguiente
+// - LMS (leftmost S): posición S cuyo anterior es L
+// Fases del algoritmo:
+// 1. Inducir el orden de las subcadenas LMS a partir de sus buckets
+// 2. Nombrar las subcadenas LMS; si hay repetidas, resolver recursivamente
+// 3. Inducir el orden final de todos los sufijos desde los LMS ordenados
+// Complejidad: O(n + upper), la recursión trabaja sobre a lo sumo n/2
+// símbolos
+// El resultado se escribe en sa, que debe tener s.size() posiciones.
+template <typename Int, typename Text>
+void sa_is(const Text &s, Int upper, std::span<Int> sa) {
+  using Symbol = std::make_unsigned_t<typename Text::value_type>;
+  auto at = [&s](Int i) { return static_cast<Int>(static_cast<Symbol>(s[i])); };
 
-// Devuelve la longitud de la cadena
-int SuffixArray::n() const { return static_cast<int>(s_.size()); }
+  Int n = static_cast<Int>(s.size());
+  if (n == 0)
+    return;
+  if (n == 1) {
+    sa[0] = 0;
+    return;
+  }
+  if (n == 2) {
+    sa[0] = at(0) < at(1) ? 0 : 1;
+    sa[1] = 1 - sa[0];
+    return;
+  }
 
-// Busca un patrón en la cadena usando búsqueda binaria sobre el Suffix Array
-// La búsqueda binaria es posible porque los sufijos están ordenados
-// lexicográficamente. Para cada posición media, comparamos el patrón con el
-// sufijo que comienza en sa_[mid].
-// Complejidad: O(m log n) donde m = longitud del patrón, n = longitud del texto
-bool SuffixArray::search(const std::string &pattern) const {
-  int m = static_cast<int>(pattern.size());
-  int left = 0, right = n() - 1;
-
-  // Búsqueda binaria estándar
-  while (left <= right) {
-    int mid = (left + right) / 2;
-    int pos = sa_[mid]; // Posición del sufijo en la cadena original
-
-    // Comparamos el patrón con el sufijo que empieza en pos
-    int cmp = 0;
-    for (int i = 0; i < m && pos + i < n(); ++i) {
-      if (pattern[i] < s_[pos + i]) {
-        cmp = -1; // El patrón es menor, buscar a la izquierda
-        break;
-      } else if (pattern[i] > s_[pos + i]) {
-        cmp = 1; // El patrón es mayor, buscar a la derecha
-        break;
+  std::vector<bool> ls(n); // true = tipo S
+  for (Int i = n - 2; i >= 0; --i)
+    ls[i] = (at(i) == at(i + 1)) ? ls[i + 1] : (at(i) < at(i + 1));
+
+  // sum_l[c]: inicio del bucket de c (zona L); sum_s[c]: inicio de la zona S
+  std::vector<Int> sum_l(upper + 1), sum_s(upper + 1);
+  for (Int i = 0; i < n; ++i) {
+    if (!ls[i])
+      sum_s[at(i)]++;
+    else
+      sum_l[at(i) + 1]++;
+  }
+  for (Int i = 0; i <= upper; ++i) {
+    sum_s[i] += sum_l[i];
+    if (i < upper)
+      sum_l[i + 1] += sum_s[i];
+  }
+
+  // Ordenamiento inducido: coloca los LMS al final de sus buckets, induce los
+  // tipo L de izquierda a derecha y luego los tipo S de derecha a izquierda
+  std::vector<Int> buf(upper + 1);
+  auto induce = [&](const std::vector<Int> &lms) {
+    std::fill(sa.begin(), sa.end(), -1);
+    std::copy(sum_s.begin(), sum_s.end(), buf.begin());
+    for (Int d : lms) {
+      if (d == n)
+        continue;
+      sa[buf[at(d)]++] = d;
+    }
+    std::copy(sum_l.begin(), sum_l.end(), buf.begin());
+    sa[buf[at(n - 1)]++] = n - 1;
+    for (Int i = 0; i < n; ++i) {
+      Int v = sa[i];
+      if (v >= 1 && !ls[v - 1])
+        sa[buf[at(v - 1)]++] = v - 1;
+    }
+    std::copy(sum_l.begin(), sum_l.end(), buf.begin());
+    for (Int i = n - 1; i >= 0; --i) {
+      Int v = sa[i];
+      if (v >= 1 && ls[v - 1])
+        sa[--buf[at(v - 1) + 1]] = v - 1;
+    }
+  };
+
+  // lms_map[i]: índice de la posición LMS i dentro de la lista de LMS
+  std::vector<Int> lms_map(n + 1, -1);
+  Int m = 0;
+  for (Int i = 1; i < n; ++i)
+    if (!ls[i - 1] && ls[i])
+      lms_map[i] = m++;
+  std::vector<Int> lms;
+  lms.reserve(m);
+  for (Int i = 1; i < n; ++i)
+    if (!ls[i - 1] && ls[i])
+      lms.push_back(i);
+
+  induce(lms);
+
+  if (m) {
+    std::vector<Int> sorted_lms;
+    sorted_lms.reserve(m);
+    for (Int v : sa)
+      if (lms_map[v] != -1)
+        sorted_lms.push_back(v);
+
+    // Nombrar subcadenas LMS: dos subcadenas consecutivas en el orden inducido
+    // reciben el mismo nombre solo si son idénticas
+    std::vector<Int> rec_s(m);
+    Int rec_upper = 0;
+    rec_s[lms_map[sorted_lms[0]]] = 0;
+    for (Int i = 1; i < m; ++i) {
+      Int l = sorted_lms[i - 1], r = sorted_lms[i];
+      Int end_l = (lms_map[l] + 1 < m) ? lms[lms_map[l] + 1] : n;
+      Int end_r = (lms_map[r] + 1 < m) ? lms[lms_map[r] + 1] : n;
+      bool same = true;
+      if (end_l - l != end_r - r) {
+        same = false;
+      } else {
+        while (l < end_l && at(l) == at(r)) {
+          l++;
+          r++;
+        }
+        if (l == n || at(l) != at(r))
+          same = false;
+      }
+      if (!same)
+        rec_upper++;
+      rec_s[lms_map[sorted_lms[i]]] = rec_upper;
+    }
+
+    // Recursión sobre la cadena reducida para obtener el orden exacto de LMS
+    std::vector<Int> rec_sa(m);
+    sa_is<Int>(rec_s, rec_upper, std::span<Int>(rec_sa));
+    for (Int i = 0; i < m; ++i)
+      sorted_lms[i] = lms[rec_sa[i]];
+    induce(sorted_lms);
+  }
+}
+
+// SA-IS con el resultado en un vector nuevo
+template <typename Int, typename Text>
+std::vector<Int> sa_is(const Text &s, Int upper) {
+  std::vector<Int> sa(s.size());
+  sa_is<Int>(s, upper, std::span<Int>(sa));
+  return sa;
+}
+
+// Divide [0, n) en count partes casi iguales y devuelve la parte t
+std::pair<size_t, size_t> chunk_range(size_t n, size_t t, size_t count) {
+  return {n * t / count, n * (t + 1) / count};
+}
+
+// Mezcla paralela de dos secuencias ordenadas (merge path): cada tarea busca
+// por búsqueda binaria dónde empieza su tramo de salida y mezcla de forma
+// independiente. Desempata igual que std::merge (primero la secuencia a).
+template <typename T, typename Compare>
+size_t merge_path_split(const T *a, size_t na, const T *b, size_t nb,
+                        size_t out, Compare comp) {
+  size_t lo = out > nb ? out - nb : 0, hi = std::min(out, na);
+  while (lo < hi) {
+    size_t i = (lo + hi) / 2, j = out - i;
+    if (j > 0 && !comp(b[j - 1], a[i]))
+      lo = i + 1;
+    else
+      hi = i;
+  }
+  return lo;
+}
+
+// Ordenamiento paralelo: ordena pool.size() bloques con std::sort y luego los
+// mezcla por niveles, repartiendo cada mezcla entre todos los hilos
+template <typename T, typename Compare>
+void parallel_sort(ThreadPool &pool, T *first, T *last, Compare comp) {
+  size_t n = last - first;
+  if (pool.size() == 1 || n < (1u << 15)) {
+    std::sort(first, last, comp);
+    return;
+  }
+  size_t parts = 1;
+  while (parts < pool.size())
+    parts <<= 1;
+
+  std::vector<size_t> bounds(parts + 1);
+  for (size_t i = 0; i <= parts; ++i)
+    bounds[i] = n * i / parts;
+  pool.parallel_for(parts, [&](size_t i) {
+    std::sort(first + bounds[i], first + bounds[i + 1], comp);
+  });
+
+  std::vector<T> buffer(n);
+  T *src = first, *dst = buffer.data();
+  for (size_t width = 1; width < parts; width *= 2) {
+    size_t pieces = 2 * width; // Tareas por cada mezcla de este nivel
+    pool.parallel_for(parts, [&](size_t t) {
+      size_t m = t / pieces, k = t % pieces;
+      size_t lo = bounds[2 * m * width], mid = bounds[(2 * m + 1) * width];
+      size_t hi = bounds[(2 * m + 2) * width];
+      size_t na = mid - lo, nb = hi - mid;
+      size_t out_begin = (na + nb) * k / pieces;
+      size_t out_end = (na + nb) * (k + 1) / pieces;
+      size_t i0 = merge_path_split(src + lo, na, src + mid, nb, out_begin, comp);
+      size_t i1 = merge_path_split(src + lo, na, src + mid, nb, out_end, comp);
+      std::merge(src + lo + i0, src + lo + i1, src + mid + (out_begin - i0),
+                 src + mid + (out_end - i1), dst + lo + out_begin, comp);
+    });
+    std::swap(src, dst);
+  }
+  if (src != first)
+    std::copy(src, src + n, first);
+}
+
+// Construye el Suffix Array en paralelo refinando grupos de sufijos empatados
+// Invariante: tras la ronda con profundidad h, los sufijos del mismo grupo
+// comparten sus primeros 2h caracteres y rank[i] es la última posición de su
+// grupo en sa (convención de Larsson-Sadakane). Los grupos son independientes,
+// así que cada ronda los ordena en paralelo por rank[i + h]. Fases:
+// 1. Clave inicial de 7 caracteres (9 bits cada uno, 0 = fin de cadena)
+// 2. Ordenamiento paralelo por esa clave y asignación de grupos
+// 3. Rondas de refinamiento: ordenar cada grupo (solo lectura de rank) y
+//    luego reasignar rank y formar los subgrupos (escrituras disjuntas)
+// Los grupos grandes se ordenan con todos los hilos; los pequeños se reparten
+// en lotes de tamaño similar.
+template <typename Int>
+std::vector<Int> parallel_sa(std::string_view s, unsigned threads) {
+  Int n = static_cast<Int>(s.size());
+  if (n == 0)
+    return {};
+  if (n == 1)
+    return {0};
+
+  ThreadPool pool(threads);
+  const size_t tasks = static_cast<size_t>(pool.size()) * 4;
+  const Int depth = 7; // Caracteres empaquetados en la clave inicial
+
+  // Fase 1 y 2: ordenar por los primeros 7 caracteres
+  std::vector<std::pair<uint64_t, Int>> keyed(n);
+  pool.parallel_for(tasks, [&](size_t t) {
+    auto [begin, end] = chunk_range(n, t, tasks);
+    for (size_t i = begin; i < end; ++i) {
+      uint64_t key = 0;
+      for (Int d = 0; d < depth; ++d) {
+        size_t pos = i + d;
+        uint64_t c = pos < static_cast<size_t>(n)
+                         ? static_cast<unsigned char>(s[pos]) + 1
+                         : 0;
+        key = (key << 9) | c;
       }
+      keyed[i] = {key, static_cast<Int>(i)};
     }
+  });
+  parallel_sort(pool, keyed.data(), keyed.data() + n,
+                std::less<std::pair<uint64_t, Int>>());
 
-    // Si llegamos aquí con cmp == 0, encontramos el patrón completo
-    if (cmp == 0 && pos + m <= n()) {
-      return true;
+  std::vector<Int> sa(n), rank(n);
+  std::vector<Int> key(n); // Clave de ordenamiento de la ronda actual
+  pool.parallel_for(tasks, [&](size_t t) {
+    auto [begin, end] = chunk_range(n, t, tasks);
+    for (size_t j = begin; j < end; ++j) {
+      sa[j] = keyed[j].second;
+      // key[j] = 1 si j es el último elemento de su grupo
+      key[j] = (j + 1 == static_cast<size_t>(n) ||
+                keyed[j].first != keyed[j + 1].first);
     }
+  });
+  std::vector<std::pair<uint64_t, Int>>().swap(keyed);
 
-    // Ajustamos los límites de búsqueda
-    if (cmp < 0) {
-      right = mid - 1;
-    } else {
-      left = mid + 1;
+  // Asignar rank = fin del grupo. Un grupo puede cruzar el límite entre
+  // tareas, así que primero se localiza el primer fin de grupo de cada tarea.
+  std::vector<Int> first_end(tasks + 1, n - 1);
+  pool.parallel_for(tasks, [&](size_t t) {
+    auto [begin, end] = chunk_range(n, t, tasks);
+    for (size_t j = begin; j < end; ++j)
+      if (key[j]) {
+        first_end[t] = static_cast<Int>(j);
+        break;
+      }
+  });
+  std::vector<Int> next_end(tasks, n - 1); // Primer fin después de la tarea
+  for (size_t t = tasks - 1; t-- > 0;) {
+    auto [begin, end] = chunk_range(n, t + 1, tasks);
+    next_end[t] = (begin < end && first_end[t + 1] < static_cast<Int>(end))
+                      ? first_end[t + 1]
+                      : next_end[t + 1];
+  }
+
+  using Group = std::pair<Int, Int>; // Rango [inicio, fin) dentro de sa
+  std::vector<std::vector<Group>> found(tasks);
+  pool.parallel_for(tasks, [&](size_t t) {
+    auto [begin, end] = chunk_range(n, t, tasks);
+    Int current = next_end[t];
+    for (size_t j = end; j-- > begin;) {
+      if (key[j])
+        current = static_cast<Int>(j);
+      rank[sa[j]] = current;
+      bool starts_group = (j == 0 || key[j - 1]);
+      if (starts_group && current > static_cast<Int>(j))
+        found[t].push_back({static_cast<Int>(j), current + 1});
+    }
+  });
+
+  std::vector<Group> groups;
+  for (auto &local : found)
+    groups.insert(groups.end(), local.begin(), local.end());
+
+  // Fase 3: refinar grupos duplicando la profundidad comparada
+  for (long long h = depth; !groups.empty(); h *= 2) {
+    auto sort_key = [&](Int x) {
+      return x + h < n ? rank[x + h] : -1; // -1: el sufijo termina antes
+    };
+    auto by_key = [&](Int a, Int b) { return sort_key(a) < sort_key(b); };
+
+    size_t total = 0;
+    for (const auto &g : groups)
+      total += g.second - g.first;
+    size_t batch_size = std::max<size_t>(total / tasks, 1);
+
+    // Lotes contiguos de grupos con aproximadamente batch_size sufijos
+    std::vector<size_t> batches = {0};
+    for (size_t i = 0, acc = 0; i < groups.size(); ++i) {
+      acc += groups[i].second - groups[i].first;
+      if (acc >= batch_size) {
+        batches.push_back(i + 1);
+        acc = 0;
+      }
     }
+    if (batches.back() != groups.size())
+      batches.push_back(groups.size());
+    size_t batch_count = batches.size() - 1;
+
+    // Ordenar: los grupos grandes usan todos los hilos
+    for (const auto &[begin, end] : groups)
+      if (static_cast<size_t>(end - begin) > batch_size)
+        parallel_sort(pool, sa.data() + begin, sa.data() + end, by_key);
+    pool.parallel_for(batch_count, [&](size_t b) {
+      for (size_t i = batches[b]; i < batches[b + 1]; ++i) {
+        auto [begin, end] = groups[i];
+        if (static_cast<size_t>(end - begin) <= batch_size)
+          std::sort(sa.data() + begin, sa.data() + end, by_key);
+        for (Int j = begin; j < end; ++j)
+          key[j] = sort_key(sa[j]);
+      }
+    });
+
+    // Reasignar rankings y formar subgrupos (rank ya no se lee en esta fase)
+    std::vector<std::vector<Group>> next(batch_count);
+    pool.parallel_for(batch_count, [&](size_t b) {
+      for (size_t i = batches[b]; i < batches[b + 1]; ++i) {
+        auto [begin, end] = groups[i];
+        Int current = end - 1;
+        for (Int j = end - 1; j >= begin; --j) {
+          if (j + 1 < end && key[j] != key[j + 1]) {
+            if (current > j + 1)
+              next[b].push_back({j + 1, current + 1});
+            current = j;
+          }
+          rank[sa[j]] = current;
+        }
+        if (current > begin)
+          next[b].push_back({begin, current + 1});
+      }
+    });
+
+    groups.clear();
+    for (auto &local : next)
+      groups.insert(groups.end(), local.begin(), local.end());
   }
-  return false;
+
+  return sa;
 }
 
+
 // Construye el Suffix Array usando el algoritmo de duplicación (Prefix
 // Doubling) Este algoritmo ordena los sufijos en O(n log n) comparando prefijos
 // cada vez más largos. En cada iteración k, comparamos prefijos de longitud 2^k
@@ -59,8 +387,8 @@ bool SuffixArray::search(const std::string &pattern) const {
 // 2. Duplicación: en cada paso k, ordenar por prefijos de longitud 2^k
 // 3. Usar counting sort (O(n)) en lugar de comparison sort para eficiencia
 // Complejidad total: O(n log n)
-std::vector<int> SuffixArray::build_sa(const std::string &s) {
-  int n = static_cast<int>(s.size());
+template <typename Int> std::vector<Int> doubling_sa(std::string_view s) {
+  Int n = static_cast<Int>(s.size());
 
   // Casos base
   if (n == 0)
@@ -69,62 +397,64 @@ std::vector<int> SuffixArray::build_sa(const std::string &s) {
     return {0};
 
   // Arreglos necesarios para el algoritmo
-  std::vector<int> sa(n);       // Suffix Array (resultado final)
-  std::vector<int> rank(n);     // Ranking de cada sufijo
-  std::vector<int> tmp_sa(n);   // Suffix Array temporal para el ordenamiento
-  std::vector<int> tmp_rank(n); // Ranking temporal para actualizar
+  std::vector<Int> sa(n);       // Suffix Array (resultado final)
+  std::vector<Int> rank(n);     // Ranking de cada sufijo
+  std::vector<Int> tmp_sa(n);   // Suffix Array temporal para el ordenamiento
+  std::vector<Int> tmp_rank(n); // Ranking temporal para actualizar
 
   // Inicialización: asignar ranking basado en el primer carácter
-  for (int i = 0; i < n; ++i) {
+  for (Int i = 0; i < n; ++i) {
     sa[i] = i; // Inicialmente cada sufijo está en su posición original
     rank[i] = static_cast<unsigned char>(s[i]); // Ranking = valor ASCII
   }
 
   // max_val rastrea el valor máximo de ranking (para optimizar counting sort)
-  int max_val = 256; // Inicialmente 256 porque usamos ASCII
-  std::vector<int> cnt(std::max(max_val, n)); // Array de conteo para sorting
+  Int max_val = 256; // Inicialmente 256 porque usamos ASCII
+  // Array de conteo: las claves de la segunda mitad van de 0 a max_val
+  std::vector<Int> cnt(std::max(max_val, n) + 1);
 
   // Primera pasada: ordenar por el primer carácter usando counting sort
-  for (int i = 0; i < n; ++i)
+  for (Int i = 0; i < n; ++i)
     cnt[rank[i]]++;
-  for (int i = 1; i < max_val; ++i)
+  for (Int i = 1; i < max_val; ++i)
     cnt[i] += cnt[i - 1];
-  for (int i = n - 1; i >= 0; --i)
+  for (Int i = n - 1; i >= 0; --i)
     sa[--cnt[rank[i]]] = i;
 
   // Algoritmo de duplicación: en cada iteración comparamos prefijos de longitud
   // 2k
-  for (int k = 1; k < n; k *= 2) {
+  for (Int k = 1; k < n; k *= 2) {
     // Fase 1: Ordenar por la segunda mitad (sufijo que empieza en pos+k)
-    std::fill(cnt.begin(), cnt.end(), 0);
-    for (int i = 0; i < n; ++i) {
-      // Si pos+k está fuera de límites, su ranking es 0 (menor que cualquier
-      // carácter)
-      int idx = (sa[i] + k < n) ? rank[sa[i] + k] : 0;
+    // Solo se limpian las max_val + 1 entradas que usa esta iteración
+    std::fill(cnt.begin(), cnt.begin() + max_val + 1, 0);
+    for (Int i = 0; i < n; ++i) {
+      // Si pos+k está fuera de límites, su clave es 0 (menor que cualquier
+      // ranking); los rankings válidos se desplazan en 1 para no colisionar
+      Int idx = (sa[i] + k < n) ? rank[sa[i] + k] + 1 : 0;
       cnt[idx]++;
     }
     // Acumular conteos
-    for (int i = 1; i < std::max(max_val, n); ++i)
+    for (Int i = 1; i <= max_val; ++i)
       cnt[i] += cnt[i - 1];
     // Construir el arreglo temporal ordenado por la segunda mitad
-    for (int i = n - 1; i >= 0; --i) {
-      int idx = (sa[i] + k < n) ? rank[sa[i] + k] : 0;
+    for (Int i = n - 1; i >= 0; --i) {
+      Int idx = (sa[i] + k < n) ? rank[sa[i] + k] + 1 : 0;
       tmp_sa[--cnt[idx]] = sa[i];
     }
 
     // Fase 2: Ordenar por la primera mitad (manteniendo el orden de la segunda)
-    std::fill(cnt.begin(), cnt.end(), 0);
-    for (int i = 0; i < n; ++i)
+    std::fill(cnt.begin(), cnt.begin() + max_val, 0);
+    for (Int i = 0; i < n; ++i)
       cnt[rank[tmp_sa[i]]]++;
-    for (int i = 1; i < std::max(max_val, n); ++i)
+    for (Int i = 1; i < max_val; ++i)
       cnt[i] += cnt[i - 1];
-    for (int i = n - 1; i >= 0; --i)
+    for (Int i = n - 1; i >= 0; --i)
       sa[--cnt[rank[tmp_sa[i]]]] = tmp_sa[i];
 
     // Recalcular rankings basados en el nuevo orden
     tmp_rank[sa[0]] = 0; // El primer sufijo tiene ranking 0
-    for (int i = 1; i < n; ++i) {
-      int p1 = sa[i - 1], p2 = sa[i]; // Posiciones de dos sufijos consecutivos
+    for (Int i = 1; i < n; ++i) {
+      Int p1 = sa[i - 1], p2 = sa[i]; // Posiciones de dos sufijos consecutivos
 
       // Verificar si ambos sufijos son iguales en sus primeros 2k caracteres
       bool same = (rank[p1] == rank[p2]); // Primera mitad igual?
@@ -138,8 +468,8 @@ std::vector<int> SuffixArray::build_sa(const std::string &s) {
       tmp_rank[sa[i]] = tmp_rank[sa[i - 1]] + (same ? 0 : 1);
     }
 
-    // Actualizar rankings para la siguiente iteración
-    rank = tmp_rank;
+    // Actualizar rankings para la siguiente iteración (intercambio sin copia)
+    rank.swap(tmp_rank);
     max_val = rank[sa[n - 1]] + 1;
 
     // Optimización: si todos los sufijos tienen rankings diferentes, ya
@@ -150,3 +480,1277 @@ std::vector<int> SuffixArray::build_sa(const std::string &s) {
 
   return sa;
 }
+
+// Convierte el resultado calculado en el tipo aritmético al tipo almacenado.
+// Para los enteros nativos ambos tipos coinciden y no se copia nada.
+template <typename Index, typename Int>
+std::vector<Index> to_index(std::vector<Int> &&values) {
+  if constexpr (std::is_same_v<Index, Int>) {
+    return std::move(values);
+  } else {
+    return std::vector<Index>(values.begin(), values.end());
+  }
+}
+
+// Rechaza textos cuyo tamaño no puede representarse con el tipo de índice,
+// en lugar de desbordar los enteros en silencio
+template <typename Index> void check_fits(size_t n) {
+  if (!BasicSuffixArray<Index>::fits(n))
+    throw std::length_error("SuffixArray: el texto de " + std::to_string(n) +
+                            " caracteres no cabe en el tipo de índice");
+}
+
+// Rellena LCP-LR para el intervalo [lo, hi] de la búsqueda binaria y devuelve
+// LCP(sa[lo], sa[hi]) = min(lcp[lo+1..hi]). Cada punto medio aparece en un
+// solo intervalo, así que basta un arreglo por lado indexado por el medio.
+template <typename Index>
+std::int64_t fill_lcp_lr(std::span<const Index> lcp,
+                         std::vector<Index> &left, std::vector<Index> &right,
+                         size_t lo, size_t hi) {
+  if (hi - lo == 1)
+    return lcp[hi];
+  size_t mid = lo + (hi - lo) / 2;
+  std::int64_t l = fill_lcp_lr(lcp, left, right, lo, mid);
+  std::int64_t r = fill_lcp_lr(lcp, left, right, mid, hi);
+  left[mid] = l;
+  right[mid] = r;
+  return std::min(l, r);
+}
+
+// Cabecera del archivo de índice. Los desplazamientos son desde el inicio
+// del archivo; una sección ausente tiene desplazamiento 0.
+struct IndexFileHeader {
+  char magic[8];             // "SAINDEX"
+  std::uint32_t version;     // Versión del formato
+  std::uint32_t index_width; // sizeof(Index): 4, 5 u 8
+  std::uint64_t byte_order;  // kByteOrderMark escrito en orden del equipo
+  std::uint64_t text_size;   // n
+  std::uint64_t text_offset;
+  std::uint64_t sa_offset;
+  std::uint64_t lcp_offset;
+  std::uint64_t checksum; // FNV-1a de todo lo que sigue a la cabecera
+};
+
+constexpr char kIndexMagic[8] = {'S', 'A', 'I', 'N', 'D', 'E', 'X', '\0'};
+constexpr std::uint32_t kIndexVersion = 1;
+constexpr std::uint64_t kByteOrderMark = 0x0102030405060708ULL;
+
+// FNV-1a de 64 bits, acumulable por tramos
+constexpr std::uint64_t kFnvOffset = 0xcbf29ce484222325ULL;
+std::uint64_t fnv1a(const char *data, size_t size,
+                    std::uint64_t hash = kFnvOffset) {
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+// Arreglo inverso del SA: rank[sa[i]] = i
+template <typename Index>
+std::vector<Index> inverse_of(std::span<const Index> sa) {
+  using Value = typename IndexTraits<Index>::value_type;
+  std::vector<Index> rank(sa.size());
+  for (size_t i = 0; i < sa.size(); ++i)
+    rank[static_cast<Value>(sa[i])] = static_cast<Value>(i);
+  return rank;
+}
+
+// Núcleo de Kasai con el arreglo inverso ya calculado
+// Text puede ser el texto o una secuencia de símbolos enteros
+template <typename Index, typename Text>
+std::vector<Index> kasai(const Text &s, std::span<const Index> sa,
+                         std::span<const Index> rank) {
+  using Value = typename IndexTraits<Index>::value_type;
+  size_t n = sa.size();
+  std::vector<Index> lcp(n, 0);
+
+  size_t h = 0; // Longitud del LCP actual
+  for (size_t i = 0; i < n; ++i) {
+    size_t r = static_cast<Value>(rank[i]);
+    if (r > 0) {
+      // Sufijo anterior en orden lexicográfico
+      size_t j = static_cast<Value>(sa[r - 1]);
+
+      // Calcular LCP entre sufijos i y j (sobre bytes, por bloques)
+      if constexpr (std::is_same_v<Text, std::string_view>) {
+        std::size_t limit = n - std::max(i, j);
+        if (h < limit)
+          h += SuffixCompare::mismatch(s.data() + i + h, s.data() + j + h,
+                                       limit - h);
+      } else {
+        while (i + h < n && j + h < n && s[i + h] == s[j + h]) {
+          h++;
+        }
+      }
+
+      lcp[r] = static_cast<Value>(h);
+
+      // Optimización: el siguiente LCP será al menos h-1
+      if (h > 0)
+        h--;
+    }
+  }
+  return lcp;
+}
+
+// Las secciones empiezan en múltiplos de 8 para poder leer el arreglo
+// directamente desde el mapeo
+std::uint64_t align8(std::uint64_t offset) { return (offset + 7) & ~7ULL; }
+
+// Construcción en memoria externa (build_external)
+//
+// Suffix Arrays parciales por bloques, de derecha a izquierda, como SAscan
+// (Kärkkäinen y Kempa 2014). Con e el final del bloque actual, gt[s] indica
+// si el sufijo s es mayor que el sufijo e:
+// - Orden del bloque: dos sufijos del bloque se comparan dentro del bloque;
+//   si uno llega al final antes de decidir, decide gt en la posición a la
+//   que llegó el otro. Eso se codifica en el símbolo 3c + v (v = 2 gt[q+1],
+//   o 1 en la última posición) y se ordena con SA-IS.
+// - gt se calcula en una pasada con el algoritmo Z contra el texto del
+//   bloque siguiente (el prefijo de T[e..]); si lo iguala completo, decide
+//   el gt de la vuelta anterior.
+// - Mezcla: el rango de cada sufijo de la cola entre los del bloque se
+//   obtiene de derecha a izquierda por búsqueda hacia atrás (LF) sobre la
+//   BWT del bloque; de ahí sale cuántos sufijos de la cola caen en cada
+//   hueco del arreglo del bloque.
+// Todos los recorridos del texto y de los archivos son secuenciales.
+constexpr std::size_t kMinExternalBudget = 64 * 1024;
+// Bytes por lectura o escritura de los archivos temporales. Nunca hay más
+// de dos búferes a la vez y salen del presupuesto.
+constexpr std::size_t kIoChunk = 1 << 13;
+
+std::runtime_error external_error(const std::string &reason) {
+  return std::runtime_error("SuffixArray::build_external: " + reason);
+}
+
+// Archivo temporal de bits que se escribe en orden
+class BitFileWriter {
+public:
+  BitFileWriter(const std::string &path, ExternalBuildStats &stats)
+      : out_(path, std::ios::binary | std::ios::trunc), path_(path),
+        stats_(stats) {
+    if (!out_)
+      throw external_error("no se pudo crear " + path);
+  }
+
+  void push(bool bit) {
+    current_ |= static_cast<unsigned char>(bit ? 1u << filled_ : 0u);
+    if (++filled_ == 8) {
+      buffer_.push_back(static_cast<char>(current_));
+      current_ = 0;
+      filled_ = 0;
+      if (buffer_.size() == kIoChunk)
+        flush();
+    }
+  }
+
+  void close() {
+    if (filled_ != 0)
+      buffer_.push_back(static_cast<char>(current_));
+    flush();
+    out_.close();
+  }
+
+private:
+  std::ofstream out_;
+  std::string path_;
+  ExternalBuildStats &stats_;
+  std::string buffer_;
+  unsigned char current_ = 0;
+  unsigned filled_ = 0;
+
+  void flush() {
+    out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    if (!out_)
+      throw external_error("no se pudo escribir " + path_);
+    stats_.bytes_written += buffer_.size();
+    buffer_.clear();
+  }
+};
+
+// Lee un archivo de bits por tramos de kIoChunk bytes. Los accesos deben
+// avanzar o retroceder de forma casi secuencial: cada salto fuera del tramo
+// cargado lee otro.
+class BitFileReader {
+public:
+  BitFileReader(const std::string &path, ExternalBuildStats &stats)
+      : in_(path, std::ios::binary | std::ios::ate), path_(path),
+        stats_(stats) {
+    if (!in_)
+      throw external_error("no se pudo leer " + path);
+    size_ = static_cast<std::uint64_t>(in_.tellg());
+  }
+
+  bool operator[](std::uint64_t i) {
+    std::uint64_t byte = i / 8;
+    if (byte < first_ || byte >= first_ + buffer_.size())
+      load(byte);
+    return (static_cast<unsigned char>(buffer_[byte - first_]) >> (i % 8)) & 1;
+  }
+
+private:
+  std::ifstream in_;
+  std::string path_;
+  ExternalBuildStats &stats_;
+  std::uint64_t size_ = 0;
+  std::uint64_t first_ = 0; // Primer byte del tramo cargado
+  std::string buffer_;
+
+  void load(std::uint64_t byte) {
+    if (byte >= size_)
+      throw external_error(path_ + " es más corto de lo esperado");
+    first_ = byte - byte % kIoChunk;
+    buffer_.resize(static_cast<std::size_t>(
+        std::min<std::uint64_t>(kIoChunk, size_ - first_)));
+    in_.seekg(static_cast<std::streamoff>(first_));
+    in_.read(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    if (!in_)
+      throw external_error("no se pudo leer " + path_);
+    stats_.bytes_read += buffer_.size();
+  }
+};
+
+// Arreglo de sufijos que se escribe en orden, a un archivo temporal o a la
+// sección del índice (entonces acumula el checksum)
+template <typename Index> class IndexWriter {
+public:
+  IndexWriter(std::ofstream &out, std::uint64_t *hash,
+              ExternalBuildStats &stats)
+      : out_(out), hash_(hash), stats_(stats) {
+    buffer_.reserve(kIoChunk / sizeof(Index));
+  }
+
+  void push(Index value) {
+    buffer_.push_back(value);
+    if (buffer_.size() == buffer_.capacity())
+      flush();
+  }
+
+  void flush() {
+    const char *data = reinterpret_cast<const char *>(buffer_.data());
+    std::size_t bytes = buffer_.size() * sizeof(Index);
+    out_.write(data, static_cast<std::streamsize>(bytes));
+    if (!out_)
+      throw external_error("no se pudo escribir el arreglo de sufijos");
+    if (hash_)
+      *hash_ = fnv1a(data, bytes, *hash_);
+    stats_.bytes_written += bytes;
+    buffer_.clear();
+  }
+
+private:
+  std::ofstream &out_;
+  std::uint64_t *hash_;
+  ExternalBuildStats &stats_;
+  std::vector<Index> buffer_;
+};
+
+// Función Z: z[i] = prefijo común más largo de p y p[i..] (z[0] = |p|)
+std::vector<std::uint32_t> z_function(std::string_view p) {
+  std::vector<std::uint32_t> z(p.size(), 0);
+  if (p.empty())
+    return z;
+  z[0] = static_cast<std::uint32_t>(p.size());
+  for (std::size_t i = 1, left = 0, right = 0; i < p.size(); ++i) {
+    std::size_t l = i < right ? std::min<std::size_t>(z[i - left], right - i)
+                              : 0;
+    while (i + l < p.size() && p[l] == p[i + l])
+      l++;
+    z[i] = static_cast<std::uint32_t>(l);
+    if (i + l > right) {
+      left = i;
+      right = i + l;
+    }
+  }
+  return z;
+}
+
+template <typename Index> class BlockwiseBuilder {
+public:
+  using Value = typename IndexTraits<Index>::value_type;
+
+  // Memoria por carácter del bloque: texto, símbolos codificados y el
+  // espacio de SA-IS (arreglo, mapa de LMS y recursión), que es la fase más
+  // cara; la mezcla necesita menos (BWT, arreglo y huecos).
+  static constexpr std::size_t kBytesPerChar = 6 + 4 * sizeof(Value);
+
+  BlockwiseBuilder(std::string_view text, std::string prefix,
+                   std::size_t block, ExternalBuildStats &stats)
+      : text_(text), prefix_(std::move(prefix)), block_(block),
+        stats_(stats) {}
+
+  // Borra los temporales que queden si algo falló a mitad de camino
+  ~BlockwiseBuilder() {
+    for (const auto &file : files_)
+      std::remove(file.c_str());
+  }
+
+  // Procesa los bloques de derecha a izquierda; el arreglo del último paso
+  // (todo el texto) se escribe en out acumulando el checksum. Los bloques se
+  // cuentan desde el final para que el corto sea el primero del texto y
+  // next_ sea siempre al menos tan largo como el bloque actual.
+  void build(std::ofstream &out, std::uint64_t &hash) {
+    std::size_t n = text_.size();
+    for (std::size_t end = n; end > 0;) {
+      std::size_t start = end > block_ ? end - block_ : 0;
+      std::string block(text_.substr(start, end - start));
+      stats_.bytes_read += block.size();
+
+      std::string gt_path = temporary();
+      std::vector<bool> gt = compute_gt(start, end, gt_path);
+      next_.clear();
+      next_.shrink_to_fit();
+      std::vector<Index> sa = sort_block(block, gt);
+      gt.clear();
+      gt.shrink_to_fit();
+      std::vector<std::uint64_t> gap =
+          end < n ? gap_counts(block, sa, start, end, gt_path)
+                  : std::vector<std::uint64_t>(sa.size() + 1, 0);
+      discard(gt_file_);
+      gt_file_ = gt_path;
+
+      if (start == 0) {
+        IndexWriter<Index> writer(out, &hash, stats_);
+        merge(sa, start, gap, writer);
+      } else {
+        std::string sa_path = temporary();
+        std::ofstream file(sa_path, std::ios::binary | std::ios::trunc);
+        IndexWriter<Index> writer(file, nullptr, stats_);
+        merge(sa, start, gap, writer);
+        discard(sa_file_);
+        sa_file_ = sa_path;
+      }
+      next_ = std::move(block);
+      stats_.blocks++;
+      end = start;
+    }
+    discard(gt_file_);
+    discard(sa_file_);
+  }
+
+private:
+  std::string_view text_;
+  std::string prefix_; // Ruta de los temporales sin el número
+  std::size_t block_;
+  ExternalBuildStats &stats_;
+  std::vector<std::string> files_;
+  std::string next_;    // Texto del bloque de la derecha (prefijo de la cola)
+  std::string gt_file_; // gt respecto al inicio de la cola, desde ese inicio
+  std::string sa_file_; // Arreglo de sufijos de la cola
+
+  std::string temporary() {
+    files_.push_back(prefix_ + std::to_string(files_.size()));
+    return files_.back();
+  }
+
+  static void discard(std::string &file) {
+    if (!file.empty())
+      std::remove(file.c_str());
+    file.clear();
+  }
+
+  void note_memory(std::size_t bytes) {
+    stats_.peak_memory_bytes = std::max(stats_.peak_memory_bytes, bytes);
+  }
+
+  // gt respecto a end para cada s en [start, n), escrito en path (el bit de
+  // end queda en 0). Devuelve la parte del bloque, [start, end).
+  std::vector<bool> compute_gt(std::size_t start, std::size_t end,
+                               const std::string &path) {
+    std::size_t n = text_.size();
+    BitFileWriter writer(path, stats_);
+    std::vector<bool> block_gt(end - start, true);
+    if (end == n) {
+      // Cola vacía: todo sufijo es mayor que el sufijo vacío
+      for (std::size_t s = start; s < n; ++s)
+        writer.push(true);
+      writer.close();
+      return block_gt;
+    }
+
+    // next_ = T[end, end + m). Si T[s..] lo iguala completo, el orden lo da
+    // T[s+m..] contra T[end+m..], que es el gt de la vuelta anterior.
+    std::string_view p = next_;
+    std::size_t m = p.size();
+    std::vector<std::uint32_t> z = z_function(p);
+    note_memory(2 * (end - start) + m + z.size() * sizeof(std::uint32_t) +
+                2 * kIoChunk);
+    BitFileReader previous(gt_file_, stats_);
+    std::size_t left = 0, right = 0; // T[left, right) = p[0, right - left)
+    for (std::size_t s = start; s < n; ++s) {
+      bool greater = false;
+      if (s != end) {
+        std::size_t l =
+            s < right ? std::min<std::size_t>(z[s - left], right - s) : 0;
+        if (s + l >= right) {
+          while (s + l < n && l < m && text_[s + l] == p[l])
+            l++;
+          left = s;
+          right = s + l;
+        }
+        if (l == m)
+          greater = s + m < n && previous[s + m - end];
+        else if (s + l < n)
+          greater = static_cast<unsigned char>(text_[s + l]) >
+                    static_cast<unsigned char>(p[l]);
+      }
+      writer.push(greater);
+      if (s < end)
+        block_gt[s - start] = greater;
+    }
+    writer.close();
+    stats_.bytes_read += n - start;
+    return block_gt;
+  }
+
+  // Orden de los sufijos del bloque (posiciones relativas al bloque)
+  std::vector<Index> sort_block(const std::string &block,
+                                const std::vector<bool> &gt) {
+    std::size_t b = block.size();
+    std::vector<std::uint32_t> symbols(b);
+    for (std::size_t q = 0; q < b; ++q)
+      symbols[q] = 3 * static_cast<unsigned char>(block[q]) +
+                   (q + 1 < b ? (gt[q + 1] ? 2 : 0) : 1);
+    note_memory(b + b / 8 + b * sizeof(std::uint32_t) +
+                b * (3 * sizeof(Value) + sizeof(Index)));
+    return BasicSuffixArray<Index>::build_sa_sais(symbols, 3 * 255 + 2);
+  }
+
+  // gap[r] = sufijos de la cola entre las filas r - 1 y r del bloque
+  std::vector<std::uint64_t> gap_counts(const std::string &block,
+                                        std::span<const Index> sa,
+                                        std::size_t start, std::size_t end,
+                                        const std::string &gt_path) {
+    std::size_t n = text_.size(), b = block.size();
+    // BWT del bloque; la fila del primer sufijo no tiene carácter anterior
+    // y se descuenta aparte
+    std::string previous_char(b, '\0');
+    std::size_t first_row = 0;
+    for (std::size_t r = 0; r < b; ++r) {
+      std::size_t q = static_cast<std::size_t>(static_cast<Value>(sa[r]));
+      if (q == 0)
+        first_row = r;
+      else
+        previous_char[r] = block[q - 1];
+    }
+    WaveletMatrix bwt(previous_char);
+    std::size_t bwt_bytes = previous_char.size() + bwt.memory_bytes();
+    previous_char.clear();
+    previous_char.shrink_to_fit();
+
+    // below[c] = sufijos del bloque que empiezan con un byte menor que c
+    std::array<std::size_t, 257> below{};
+    for (char c : block)
+      below[static_cast<unsigned char>(c) + 1]++;
+    for (std::size_t c = 1; c < below.size(); ++c)
+      below[c] += below[c - 1];
+
+    std::vector<std::uint64_t> gap(b + 1, 0);
+    note_memory(b + sa.size_bytes() + bwt_bytes +
+                gap.size() * sizeof(std::uint64_t) + kIoChunk);
+    BitFileReader gt(gt_path, stats_);
+    unsigned char last = static_cast<unsigned char>(block.back());
+    std::size_t rank = 0; // Sufijos del bloque menores que T[s+1..]
+    for (std::size_t s = n; s-- > end;) {
+      unsigned char c = static_cast<unsigned char>(text_[s]);
+      std::size_t next = below[c] + bwt.rank(c, rank);
+      if (c == 0 && first_row < rank)
+        next--;
+      // El sufijo end - 1 sigue con T[end..], que no está en el bloque
+      if (c == last && s + 1 < n && gt[s + 1 - start])
+        next++;
+      rank = next;
+      gap[rank]++;
+    }
+    stats_.bytes_read += n - end;
+    return gap;
+  }
+
+  // Intercala el arreglo del bloque con el de la cola según gap
+  void merge(std::span<const Index> sa, std::size_t start,
+             const std::vector<std::uint64_t> &gap,
+             IndexWriter<Index> &writer) {
+    std::ifstream tail;
+    if (!sa_file_.empty()) {
+      tail.open(sa_file_, std::ios::binary);
+      if (!tail)
+        throw external_error("no se pudo leer " + sa_file_);
+    }
+    std::vector<Index> buffer(kIoChunk / sizeof(Index));
+    note_memory(sa.size_bytes() + gap.size() * sizeof(std::uint64_t) +
+                2 * kIoChunk);
+    for (std::size_t r = 0; r <= sa.size(); ++r) {
+      for (std::uint64_t left = gap[r]; left > 0;) {
+        std::size_t count = static_cast<std::size_t>(
+            std::min<std::uint64_t>(left, buffer.size()));
+        tail.read(reinterpret_cast<char *>(buffer.data()),
+                  static_cast<std::streamsize>(count * sizeof(Index)));
+        if (!tail)
+          throw external_error("no se pudo leer " + sa_file_);
+        stats_.bytes_read += count * sizeof(Index);
+        for (std::size_t i = 0; i < count; ++i)
+          writer.push(buffer[i]);
+        left -= count;
+      }
+      if (r < sa.size())
+        writer.push(static_cast<Value>(sa[r]) + static_cast<Value>(start));
+    }
+    writer.flush();
+  }
+};
+
+} // namespace
+
+// Constructor: se queda con la cadena y construye el Suffix Array
+template <typename Index>
+BasicSuffixArray<Index>::BasicSuffixArray(std::string s, Algorithm algorithm,
+                                          unsigned threads) {
+  auto owned = std::make_shared<OwnedStorage>();
+  owned->text = std::move(s);
+  s_ = owned->text;
+  build_owned(std::move(owned), algorithm, threads);
+}
+
+// Construye sobre el texto del llamador sin copiarlo
+template <typename Index>
+BasicSuffixArray<Index>
+BasicSuffixArray<Index>::borrow(std::string_view text, Algorithm algorithm,
+                                unsigned threads) {
+  BasicSuffixArray result;
+  result.s_ = text;
+  result.build_owned(std::make_shared<OwnedStorage>(), algorithm, threads);
+  return result;
+}
+
+template <typename Index>
+BasicSuffixArray<Index>
+BasicSuffixArray<Index>::borrow(std::span<const std::uint8_t> bytes,
+                                Algorithm algorithm, unsigned threads) {
+  return borrow(std::string_view(reinterpret_cast<const char *>(bytes.data()),
+                                 bytes.size()),
+                algorithm, threads);
+}
+
+// Construye sobre un archivo mapeado; el mapeo vive tanto como el arreglo
+template <typename Index>
+BasicSuffixArray<Index>
+BasicSuffixArray<Index>::map_text(const std::string &path, Algorithm algorithm,
+                                  unsigned threads) {
+  auto file = std::make_shared<MappedFile>(path);
+  auto owned = std::make_shared<OwnedStorage>();
+  BasicSuffixArray result;
+  result.s_ = std::string_view(file->data(), file->size());
+  owned->text_owner = std::move(file);
+  result.build_owned(std::move(owned), algorithm, threads);
+  return result;
+}
+
+// Construye el arreglo sobre s_ (que ya apunta al texto definitivo)
+template <typename Index>
+void BasicSuffixArray<Index>::build_owned(std::shared_ptr<OwnedStorage> storage,
+                                          Algorithm algorithm,
+                                          unsigned threads) {
+  storage->sa.resize(s_.size());
+  build_sa(s_, std::span<Index>(storage->sa), algorithm, threads);
+  sa_ = storage->sa;
+  storage_ = std::move(storage);
+}
+
+// Escribe cabecera y secciones. El checksum se calcula sobre los mismos
+// bytes que se escriben, incluido el relleno, así que primero se arma la
+// lista de secciones y luego se escribe la cabecera ya completa.
+template <typename Index>
+void BasicSuffixArray<Index>::save(const std::string &path,
+                                   bool include_lcp) const {
+  std::span<const Index> lcp;
+  if (include_lcp)
+    lcp = this->lcp();
+
+  IndexFileHeader header{};
+  std::memcpy(header.magic, kIndexMagic, sizeof(kIndexMagic));
+  header.version = kIndexVersion;
+  header.index_width = sizeof(Index);
+  header.byte_order = kByteOrderMark;
+  header.text_size = s_.size();
+
+  struct Section {
+    const char *data;
+    std::uint64_t size;
+  };
+  std::vector<Section> sections = {
+      {s_.data(), s_.size()},
+      {reinterpret_cast<const char *>(sa_.data()), sa_.size_bytes()}};
+  if (include_lcp)
+    sections.push_back(
+        {reinterpret_cast<const char *>(lcp.data()), lcp.size_bytes()});
+
+  std::uint64_t *offsets[] = {&header.text_offset, &header.sa_offset,
+                              &header.lcp_offset};
+  std::uint64_t offset = sizeof(IndexFileHeader);
+  const char padding[8] = {};
+  std::uint64_t hash = kFnvOffset;
+  for (size_t i = 0; i < sections.size(); ++i) {
+    std::uint64_t start = align8(offset);
+    hash = fnv1a(padding, start - offset, hash);
+    hash = fnv1a(sections[i].data, sections[i].size, hash);
+    *offsets[i] = start;
+    offset = start + sections[i].size;
+  }
+  header.checksum = hash;
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out)
+    throw std::runtime_error("SuffixArray::save: no se pudo crear " + path);
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  offset = sizeof(IndexFileHeader);
+  for (size_t i = 0; i < sections.size(); ++i) {
+    out.write(padding, static_cast<std::streamsize>(*offsets[i] - offset));
+    out.write(sections[i].data, static_cast<std::streamsize>(sections[i].size));
+    offset = *offsets[i] + sections[i].size;
+  }
+  if (!out)
+    throw std::runtime_error("SuffixArray::save: error al escribir " + path);
+}
+
+// Valida la cabecera y apunta las vistas al archivo mapeado. El objeto
+// devuelto (y sus copias) mantiene vivo el mapeo.
+template <typename Index>
+BasicSuffixArray<Index> BasicSuffixArray<Index>::open(const std::string &path,
+                                                      bool verify) {
+  auto file = std::make_shared<MappedFile>(path);
+  auto fail = [&](const std::string &reason) {
+    return std::runtime_error("SuffixArray::open: " + path + ": " + reason);
+  };
+
+  IndexFileHeader header;
+  if (file->size() < sizeof(header))
+    throw fail("archivo demasiado corto");
+  std::memcpy(&header, file->data(), sizeof(header));
+  if (std::memcmp(header.magic, kIndexMagic, sizeof(kIndexMagic)) != 0)
+    throw fail("no es un archivo de índice");
+  if (header.version != kIndexVersion)
+    throw fail("versión de formato no soportada");
+  if (header.byte_order != kByteOrderMark)
+    throw fail("orden de bytes distinto al del equipo");
+  if (header.index_width != sizeof(Index))
+    throw fail("el índice usa " + std::to_string(header.index_width) +
+               " bytes por posición y se esperaban " +
+               std::to_string(sizeof(Index)));
+
+  // Cada sección debe caber completa dentro del archivo
+  std::uint64_t n = header.text_size;
+  std::uint64_t array_bytes = n * sizeof(Index);
+  auto in_file = [&](std::uint64_t offset, std::uint64_t size) {
+    return offset >= sizeof(header) && offset <= file->size() &&
+           size <= file->size() - offset;
+  };
+  if (n > file->size() || !in_file(header.text_offset, n) ||
+      !in_file(header.sa_offset, array_bytes) ||
+      (header.lcp_offset != 0 && !in_file(header.lcp_offset, array_bytes)))
+    throw fail("secciones fuera del archivo (¿truncado?)");
+
+  if (verify) {
+    std::uint64_t end =
+        (header.lcp_offset != 0 ? header.lcp_offset : header.sa_offset) +
+        array_bytes;
+    if (fnv1a(file->data() + sizeof(header), end - sizeof(header)) !=
+        header.checksum)
+      throw fail("checksum incorrecto");
+  }
+
+  BasicSuffixArray result;
+  const char *base = file->data();
+  result.s_ = std::string_view(base + header.text_offset, n);
+  result.sa_ = std::span<const Index>(
+      reinterpret_cast<const Index *>(base + header.sa_offset), n);
+  if (header.lcp_offset != 0)
+    result.lcp_ = std::span<const Index>(
+        reinterpret_cast<const Index *>(base + header.lcp_offset), n);
+  result.storage_ = std::move(file);
+  return result;
+}
+
+// Escribe la cabecera provisional y el texto, y luego el arreglo con
+// BlockwiseBuilder. El checksum se acumula mientras se escribe; al final se
+// reescribe la cabecera ya completa.
+template <typename Index>
+ExternalBuildStats BasicSuffixArray<Index>::build_external(
+    const std::string &text_path, const std::string &index_path,
+    std::size_t memory_budget, const std::string &scratch_dir) {
+  if (memory_budget < kMinExternalBudget)
+    throw std::invalid_argument(
+        "SuffixArray::build_external: el presupuesto debe ser de al menos "
+        "64 KB");
+  MappedFile file(text_path);
+  std::string_view text(file.data(), file.size());
+  check_fits<Index>(text.size());
+
+  IndexFileHeader header{};
+  std::memcpy(header.magic, kIndexMagic, sizeof(kIndexMagic));
+  header.version = kIndexVersion;
+  header.index_width = sizeof(Index);
+  header.byte_order = kByteOrderMark;
+  header.text_size = text.size();
+  header.text_offset = align8(sizeof(IndexFileHeader));
+  header.sa_offset = align8(header.text_offset + text.size());
+
+  std::ofstream out(index_path, std::ios::binary | std::ios::trunc);
+  if (!out)
+    throw std::runtime_error("SuffixArray::build_external: no se pudo crear " +
+                             index_path);
+  ExternalBuildStats stats;
+  const char padding[8] = {};
+  std::uint64_t hash = kFnvOffset;
+  auto write = [&](const char *data, std::uint64_t size) {
+    out.write(data, static_cast<std::streamsize>(size));
+    hash = fnv1a(data, size, hash);
+    stats.bytes_written += size;
+  };
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  stats.bytes_written += sizeof(header);
+  write(padding, header.text_offset - sizeof(header));
+  write(text.data(), text.size());
+  write(padding, header.sa_offset - header.text_offset - text.size());
+  stats.bytes_read += text.size();
+
+  // Los temporales van a scratch_dir con el nombre del índice como prefijo
+  std::string prefix =
+      (std::filesystem::path(scratch_dir) /
+       std::filesystem::path(index_path).filename())
+          .string() +
+      ".tmp";
+  {
+    std::size_t block = std::min<std::size_t>(
+        (memory_budget - 2 * kIoChunk) / BlockwiseBuilder<Index>::kBytesPerChar,
+        std::numeric_limits<std::int32_t>::max());
+    BlockwiseBuilder<Index> builder(text, prefix, block, stats);
+    builder.build(out, hash);
+  }
+
+  header.checksum = hash;
+  out.seekp(0);
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  if (!out)
+    throw std::runtime_error(
+        "SuffixArray::build_external: error al escribir " + index_path);
+  return stats;
+}
+
+// Devuelve el arreglo de sufijos
+template <typename Index>
+std::span<const Index> BasicSuffixArray<Index>::sa() const {
+  return sa_;
+}
+
+// Devuelve el LCP guardado en el archivo o, si no lo hay, el calculado con
+// Kasai a partir del arreglo inverso (ambos quedan en caché)
+template <typename Index>
+std::span<const Index> BasicSuffixArray<Index>::lcp() const {
+  if (!lcp_.empty() || s_.empty())
+    return lcp_;
+  std::call_once(lazy_->lcp_once, [this] {
+    lazy_->lcp = kasai<Index>(s_, sa_, inverse_sa());
+  });
+  return lazy_->lcp;
+}
+
+template <typename Index>
+std::span<const Index> BasicSuffixArray<Index>::inverse_sa() const {
+  std::call_once(lazy_->inverse_once,
+                 [this] { lazy_->inverse_sa = inverse_of<Index>(sa_); });
+  return lazy_->inverse_sa;
+}
+
+// Algoritmo Φ (Kärkkäinen, Manzini y Puglisi 2009): Φ[sa[i]] = sa[i-1] y
+// PLCP[i] = LCP del sufijo i con su anterior en el SA. Recorriendo el texto
+// en orden, PLCP[i+1] >= PLCP[i] - 1, igual que en Kasai, pero sin arreglo
+// inverso: PLCP se escribe sobre Φ en el mismo arreglo temporal, y luego
+// lcp[i] = PLCP[sa[i]] se guarda en bytes.
+template <typename Index>
+const CompactLcp &BasicSuffixArray<Index>::compact_lcp() const {
+  std::call_once(lazy_->compact_once, [this] {
+    std::size_t n = sa_.size();
+    CompactLcp &result = lazy_->compact_lcp;
+    result.bytes_.assign(n, 0);
+    if (n == 0)
+      return;
+
+    std::vector<Index> plcp(n); // Primero Φ; n marca "sin anterior"
+    plcp[static_cast<value_type>(sa_[0])] = static_cast<value_type>(n);
+    for (std::size_t i = 1; i < n; ++i)
+      plcp[static_cast<value_type>(sa_[i])] = sa_[i - 1];
+
+    std::size_t h = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+      std::size_t j = static_cast<value_type>(plcp[i]);
+      if (j == n) {
+        h = 0;
+      } else if (h < n - std::max(i, j)) {
+        h += SuffixCompare::mismatch(s_.data() + i + h, s_.data() + j + h,
+                                     n - std::max(i, j) - h);
+      }
+      plcp[i] = static_cast<value_type>(h);
+      if (h > 0)
+        h--;
+    }
+
+    for (std::size_t i = 1; i < n; ++i) {
+      std::size_t value = static_cast<value_type>(
+          plcp[static_cast<value_type>(sa_[i])]);
+      if (value < CompactLcp::kEscape) {
+        result.bytes_[i] = static_cast<std::uint8_t>(value);
+      } else {
+        result.bytes_[i] = CompactLcp::kEscape;
+        result.overflow_.push_back({i, value});
+      }
+    }
+  });
+  return lazy_->compact_lcp;
+}
+
+// Devuelve el texto indexado
+template <typename Index>
+std::string_view BasicSuffixArray<Index>::text() const {
+  return s_;
+}
+
+template <typename Index>
+std::shared_ptr<const void> BasicSuffixArray<Index>::keepalive() const {
+  return storage_;
+}
+
+// Devuelve la longitud de la cadena
+template <typename Index> std::size_t BasicSuffixArray<Index>::n() const {
+  return s_.size();
+}
+
+// Un texto cabe si todas sus posiciones (y n, usado como límite en los
+// algoritmos) son representables en Index
+template <typename Index> bool BasicSuffixArray<Index>::fits(std::size_t n) {
+  return n <= static_cast<std::size_t>(IndexTraits<Index>::max());
+}
+
+// Compara el sufijo con el patrón carácter a carácter como bytes sin signo,
+// el mismo orden con el que se construye el arreglo
+template <typename Index>
+int BasicSuffixArray<Index>::compare_suffix(std::size_t pos,
+                                            std::string_view pattern,
+                                            std::size_t offset,
+                                            std::size_t *matched) const {
+  std::size_t m = pattern.size();
+  std::size_t available = pos < s_.size() ? s_.size() - pos : 0;
+  std::size_t limit = std::min(m, available);
+  std::size_t i = offset;
+  int cmp = 0;
+  if (i < limit) {
+    cmp = SuffixCompare::compare(s_.data() + pos + i, pattern.data() + i,
+                                 limit - i, &i);
+    i += offset;
+  }
+  if (cmp == 0 && i < m)
+    cmp = -1; // El sufijo termina antes: es prefijo propio del patrón
+  if (matched)
+    *matched = cmp == 0 ? m : i;
+  return cmp;
+}
+
+// Búsqueda binaria de un límite del rango de coincidencias
+// Los sufijos que empiezan con el patrón son contiguos en sa(): el límite
+// inferior es el primero que compara >= 0 y el superior el primero que > 0
+template <typename Index>
+std::size_t BasicSuffixArray<Index>::bound(std::string_view pattern,
+                                           std::size_t lo, std::size_t hi,
+                                           bool upper,
+                                           std::size_t offset) const {
+  while (lo < hi) {
+    std::size_t mid = lo + (hi - lo) / 2;
+    int cmp = compare_suffix(sa_[mid], pattern, offset);
+    if (cmp < 0 || (upper && cmp == 0))
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+// Búsqueda binaria acelerada con LCP-LR (Manber y Myers, 1993)
+// Se mantiene l = LCP(patrón, sa[L]) y r = LCP(patrón, sa[R]). Si, por ejemplo,
+// l >= r y el punto medio comparte con sa[L] más de l caracteres, entonces
+// sa[M] está del mismo lado que sa[L] sin mirar el texto; si comparte menos,
+// está del lado de sa[R]. Solo con empate se comparan caracteres, y siempre a
+// partir de max(l, r), de modo que cada carácter del patrón se lee O(1) veces
+// por paso en que avanza max(l, r).
+// Complejidad: O(m + log n)
+template <typename Index>
+std::size_t BasicSuffixArray<Index>::bound_lcp_lr(std::string_view pattern,
+                                                  bool upper) const {
+  std::size_t n = sa_.size();
+  if (n == 0)
+    return 0;
+  // Un sufijo queda antes del límite si es menor que el patrón (o igual en
+  // el límite superior)
+  auto before = [upper](int cmp) { return cmp < 0 || (upper && cmp == 0); };
+
+  std::size_t l = 0, r = 0;
+  if (!before(compare_suffix(sa_[0], pattern, 0, &l)))
+    return 0;
+  if (before(compare_suffix(sa_[n - 1], pattern, 0, &r)))
+    return n;
+
+  // Invariante: sa[L] queda antes del límite y sa[R] no
+  std::size_t lo = 0, hi = n - 1;
+  while (hi - lo > 1) {
+    std::size_t mid = lo + (hi - lo) / 2;
+    std::size_t matched = 0;
+    int cmp;
+    if (l >= r) {
+      std::size_t lcp = static_cast<value_type>(lcp_left_[mid]);
+      if (lcp > l) {
+        lo = mid; // sa[mid] coincide con sa[lo] donde este difiere del patrón
+        continue;
+      }
+      if (lcp < l) {
+        hi = mid; // sa[mid] es mayor que sa[lo] donde este iguala al patrón
+        r = lcp;
+        continue;
+      }
+      cmp = compare_suffix(sa_[mid], pattern, l, &matched);
+    } else {
+      std::size_t lcp = static_cast<value_type>(lcp_right_[mid]);
+      if (lcp > r) {
+        hi = mid;
+        continue;
+      }
+      if (lcp < r) {
+        lo = mid;
+        l = lcp;
+        continue;
+      }
+      cmp = compare_suffix(sa_[mid], pattern, r, &matched);
+    }
+    if (before(cmp)) {
+      lo = mid;
+      l = matched;
+    } else {
+      hi = mid;
+      r = matched;
+    }
+  }
+  return hi;
+}
+
+// Rango inicial de búsqueda
+// prefix_table_[K] cuenta los sufijos menores que K, así que el bloque de
+// sufijos que empiezan con K arranca en prefix_table_[K]. Termina en
+// prefix_table_[K + 1] salvo por los sufijos más cortos que k (las últimas
+// k - 1 posiciones del texto) que caen justo antes de K + 1; se descuentan.
+template <typename Index>
+typename BasicSuffixArray<Index>::SearchRange
+BasicSuffixArray<Index>::root_range(std::string_view pattern) const {
+  if (!has_prefix_table() || pattern.size() < prefix_k_)
+    return {0, n(), 0};
+
+  std::size_t key = 0;
+  for (unsigned d = 0; d < prefix_k_; ++d)
+    key = (key << 8) | static_cast<unsigned char>(pattern[d]);
+  std::size_t lo = static_cast<value_type>(prefix_table_[key]);
+  std::size_t hi = static_cast<value_type>(prefix_table_[key + 1]);
+
+  for (std::size_t i = n() > prefix_k_ - 1 ? n() - (prefix_k_ - 1) : 0;
+       i < n(); ++i) {
+    std::size_t padded = 0; // Sufijo corto completado con bytes cero
+    for (unsigned d = 0; d < prefix_k_; ++d)
+      padded = (padded << 8) |
+               (i + d < n() ? static_cast<unsigned char>(s_[i + d]) : 0);
+    if (padded == key + 1)
+      hi--;
+  }
+  return {lo, hi, prefix_k_};
+}
+
+// Busca un patrón en la cadena usando búsqueda binaria sobre el Suffix Array
+// La búsqueda binaria es posible porque los sufijos están ordenados
+// lexicográficamente. Basta con encontrar el límite inferior y verificar que
+// ese sufijo empieza con el patrón.
+// Complejidad: O(m log n), u O(m + log n) con LCP-LR
+template <typename Index>
+bool BasicSuffixArray<Index>::search(std::string_view pattern) const {
+  SearchRange range = root_range(pattern);
+  std::size_t lo =
+      (range.matched == 0 && has_lcp_lr())
+          ? bound_lcp_lr(pattern, false)
+          : bound(pattern, range.lo, range.hi, false, range.matched);
+  return lo < range.hi &&
+         compare_suffix(sa_[lo], pattern, range.matched) == 0;
+}
+
+// Rango de coincidencias. Con tabla de buckets se busca dentro del bucket;
+// si no, con LCP-LR sobre todo el arreglo o con la búsqueda simple. La
+// segunda búsqueda solo recorre la parte que queda desde el límite inferior.
+template <typename Index>
+std::pair<std::size_t, std::size_t>
+BasicSuffixArray<Index>::equal_range(std::string_view pattern) const {
+  SearchRange range = root_range(pattern);
+  if (range.matched == 0 && has_lcp_lr())
+    return {bound_lcp_lr(pattern, false), bound_lcp_lr(pattern, true)};
+  std::size_t lo =
+      bound(pattern, range.lo, range.hi, false, range.matched);
+  std::size_t hi = bound(pattern, lo, range.hi, true, range.matched);
+  return {lo, hi};
+}
+
+// Búsqueda por lotes creando un pool de hilos para esta llamada
+template <typename Index>
+std::vector<std::pair<std::size_t, std::size_t>>
+BasicSuffixArray<Index>::search_batch(
+    std::span<const std::string_view> patterns, unsigned threads) const {
+  ThreadPool pool(threads);
+  return search_batch(patterns, pool);
+}
+
+// Búsqueda por lotes
+// Al recorrer las consultas ordenadas se mantiene una pila con las consultas
+// anteriores que son prefijo de la última (como una rama de un trie). Para
+// la consulta actual se descartan las que no son prefijo suyo; la cima da un
+// rango que ya contiene la respuesta y cuántos caracteres se saben iguales.
+// Complejidad: O(Q log Q) para ordenar y, por consulta, O((m - d) log k)
+// donde d es el prefijo compartido y k el tamaño del rango heredado
+template <typename Index>
+std::vector<std::pair<std::size_t, std::size_t>>
+BasicSuffixArray<Index>::search_batch(
+    std::span<const std::string_view> patterns, ThreadPool &pool) const {
+  std::size_t q = patterns.size();
+  std::vector<std::pair<std::size_t, std::size_t>> ranges(q);
+  std::vector<std::size_t> order(q);
+  for (std::size_t i = 0; i < q; ++i)
+    order[i] = i;
+  std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+    return patterns[a] < patterns[b];
+  });
+
+  // Bloques contiguos del orden: cada uno reutiliza sus propios prefijos
+  std::size_t tasks = std::min<std::size_t>(q, pool.size() * 4);
+  pool.parallel_for(tasks, [&](std::size_t t) {
+    struct Frame {
+      std::size_t depth, lo, hi; // Consulta de longitud depth y su rango
+    };
+    std::vector<Frame> stack;
+    std::string_view previous;
+    auto [begin, end] = chunk_range(q, t, tasks);
+    for (std::size_t k = begin; k < end; ++k) {
+      std::string_view pattern = patterns[order[k]];
+      std::size_t common = SuffixCompare::mismatch(
+          previous.data(), pattern.data(),
+          std::min(previous.size(), pattern.size()));
+      while (!stack.empty() && stack.back().depth > common)
+        stack.pop_back();
+
+      Frame parent;
+      if (stack.empty()) {
+        SearchRange root = root_range(pattern);
+        parent = {root.matched, root.lo, root.hi};
+      } else {
+        parent = stack.back();
+      }
+      std::size_t lo =
+          bound(pattern, parent.lo, parent.hi, false, parent.depth);
+      std::size_t hi = bound(pattern, lo, parent.hi, true, parent.depth);
+      ranges[order[k]] = {lo, hi};
+      stack.push_back({pattern.size(), lo, hi});
+      previous = pattern;
+    }
+  });
+  return ranges;
+}
+
+template <typename Index>
+std::size_t BasicSuffixArray<Index>::count(std::string_view pattern) const {
+  auto [lo, hi] = equal_range(pattern);
+  return hi - lo;
+}
+
+template <typename Index>
+std::span<const Index>
+BasicSuffixArray<Index>::occurrences(std::string_view pattern) const {
+  auto [lo, hi] = equal_range(pattern);
+  return std::span<const Index>(sa_).subspan(lo, hi - lo);
+}
+
+template <typename Index>
+std::vector<typename BasicSuffixArray<Index>::value_type>
+BasicSuffixArray<Index>::locate(std::string_view pattern) const {
+  auto hits = occurrences(pattern);
+  std::vector<value_type> positions(hits.begin(), hits.end());
+  std::sort(positions.begin(), positions.end());
+  return positions;
+}
+
+// Precalcula LCP-LR a partir del LCP Array recorriendo el árbol implícito de
+// intervalos de la búsqueda binaria (mismo cálculo del punto medio)
+template <typename Index> void BasicSuffixArray<Index>::build_lcp_lr() {
+  std::size_t n = sa_.size();
+  lcp_left_.assign(n, 0);
+  lcp_right_.assign(n, 0);
+  if (n > 2) {
+    fill_lcp_lr(lcp(), lcp_left_, lcp_right_, 0, n - 1);
+  }
+}
+
+template <typename Index> bool BasicSuffixArray<Index>::has_lcp_lr() const {
+  return !lcp_left_.empty();
+}
+
+// Construye la tabla de buckets sin recorrer sa(): basta con el texto.
+// Cada sufijo aporta un valor v tal que el sufijo es menor que la cadena K
+// de k bytes si y solo si v <= K:
+// - sufijo de al menos k bytes con prefijo p: v = p + 1
+// - sufijo corto t: v = t completado con bytes cero
+// Así prefix_table_[K] es la suma acumulada del histograma de v hasta K.
+template <typename Index>
+void BasicSuffixArray<Index>::build_prefix_table(unsigned k) {
+  if (k < 1 || k > 3)
+    throw std::invalid_argument("build_prefix_table: k debe ser 1, 2 o 3");
+
+  std::size_t buckets = std::size_t(1) << (8 * k);
+  std::vector<value_type> counts(buckets + 1, 0);
+  std::size_t key = 0; // Ventana deslizante con los k bytes desde i
+  std::size_t mask = buckets - 1;
+  for (std::size_t i = 0; i < k; ++i)
+    key = (key << 8) | (i < n() ? static_cast<unsigned char>(s_[i]) : 0);
+  for (std::size_t i = 0; i < n(); ++i) {
+    counts[i + k <= n() ? key + 1 : key]++;
+    std::size_t next = i + k < n() ? static_cast<unsigned char>(s_[i + k]) : 0;
+    key = ((key << 8) | next) & mask;
+  }
+
+  prefix_table_.assign(buckets + 1, 0);
+  value_type total = 0;
+  for (std::size_t b = 0; b <= buckets; ++b) {
+    total += counts[b];
+    prefix_table_[b] = total;
+  }
+  prefix_k_ = k;
+}
+
+template <typename Index>
+bool BasicSuffixArray<Index>::has_prefix_table() const {
+  return prefix_k_ != 0;
+}
+
+template <typename Index>
+std::size_t BasicSuffixArray<Index>::prefix_table_bytes() const {
+  return prefix_table_.size() * sizeof(Index);
+}
+
+// Construye el LCP Array usando el algoritmo de Kasai
+// Recorre los sufijos en orden de texto: si el sufijo i comparte h caracteres
+// con su anterior en el SA, el sufijo i+1 comparte al menos h-1 con el suyo.
+// Ejemplo:
+// Texto: "banana"
+// SA: [5, 3, 1, 0, 4, 2] → sufijos: ["a", "ana", "anana", "banana", "na",
+// "nana"] LCP: [0, 1, 3, 0, 0, 2] → prefijos comunes entre sufijos consecutivos
+// Complejidad: O(n)
+template <typename Index>
+std::vector<Index>
+BasicSuffixArray<Index>::build_lcp(std::string_view s,
+                                   std::span<const Index> sa) {
+  return kasai<Index>(s, sa, inverse_of<Index>(sa));
+}
+
+// Construye el Suffix Array con el algoritmo seleccionado
+template <typename Index>
+std::vector<Index> BasicSuffixArray<Index>::build_sa(std::string_view s,
+                                                     Algorithm algorithm,
+                                                     unsigned threads) {
+  if (algorithm == Algorithm::Doubling)
+    return build_sa_doubling(s);
+  if (algorithm == Algorithm::Parallel)
+    return build_sa_parallel(s, threads);
+  return build_sa_sais(s);
+}
+
+// Construye el Suffix Array en el búfer del llamador. SA-IS sobre un índice
+// nativo induce directamente en out; el resto de combinaciones calcula en un
+// vector y copia.
+template <typename Index>
+void BasicSuffixArray<Index>::build_sa(std::string_view s,
+                                       std::span<Index> out,
+                                       Algorithm algorithm, unsigned threads) {
+  if (out.size() != s.size())
+    throw std::invalid_argument(
+        "build_sa: el búfer debe tener una posición por carácter");
+  if constexpr (std::is_same_v<Index, value_type>) {
+    if (algorithm == Algorithm::SAIS) {
+      check_fits<Index>(s.size());
+      sa_is<value_type>(s, value_type(255), out);
+      return;
+    }
+  }
+  std::vector<Index> sa = build_sa(s, algorithm, threads);
+  std::copy(sa.begin(), sa.end(), out.begin());
+}
+
+// Construye el Suffix Array por ordenamiento inducido (SA-IS)
+// A diferencia de la duplicación, no hace O(log n) pasadas completas sobre el
+// arreglo: cada sufijo se coloca un número constante de veces.
+// Complejidad: O(n)
+template <typename Index>
+std::vector<Index>
+BasicSuffixArray<Index>::build_sa_sais(std::string_view s) {
+  check_fits<Index>(s.size());
+  return to_index<Index>(sa_is<value_type>(s, value_type(255)));
+}
+
+// SA-IS sobre símbolos enteros: el mismo núcleo que para bytes
+template <typename Index>
+std::vector<Index>
+BasicSuffixArray<Index>::build_sa_sais(std::span<const std::uint32_t> symbols,
+                                       std::uint32_t upper) {
+  check_fits<Index>(symbols.size());
+  if (!fits(upper))
+    throw std::length_error("SuffixArray: alfabeto demasiado grande");
+  return to_index<Index>(sa_is<value_type>(symbols, value_type(upper)));
+}
+
+template <typename Index>
+std::vector<Index>
+BasicSuffixArray<Index>::build_lcp(std::span<const std::uint32_t> symbols,
+                                   std::span<const Index> sa) {
+  return kasai<Index>(symbols, sa, inverse_of<Index>(sa));
+}
+
+// Construye el Suffix Array por duplicación de prefijos
+template <typename Index>
+std::vector<Index>
+BasicSuffixArray<Index>::build_sa_doubling(std::string_view s) {
+  check_fits<Index>(s.size());
+  return to_index<Index>(doubling_sa<value_type>(s));
+}
+
+// Construye el Suffix Array en paralelo
+template <typename Index>
+std::vector<Index>
+BasicSuffixArray<Index>::build_sa_parallel(std::string_view s,
+                                           unsigned threads) {
+  check_fits<Index>(s.size());
+  return to_index<Index>(parallel_sa<value_type>(s, threads));
+}
+
+// Los valores desbordados se buscan por posición en la tabla ordenada
+std::size_t CompactLcp::overflow(std::size_t i) const {
+  auto it = std::lower_bound(
+      overflow_.begin(), overflow_.end(), i,
+      [](const std::pair<std::size_t, std::size_t> &entry, std::size_t pos) {
+        return entry.first < pos;
+      });
+  return it->second;
+}
+
+std::size_t CompactLcp::memory_bytes() const {
+  return bytes_.size() + overflow_.size() * sizeof(overflow_[0]);
+}
+
+template class BasicSuffixArray<int>;
+template class BasicSuffixArray<Index40>;
+template class BasicSuffixArray<std::int64_t>;
@@ -6,41 +6,382 @@
 #define UNTITLED_SUFFIXARRAY_H
 
 #pragma once
+#include "PackedIndex.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
-// Clase SuffixArray - Estructura de datos para búsqueda eficiente de patrones
+class ThreadPool;
+
+// Algoritmos de construcción disponibles. Todos producen el mismo arreglo.
+// - Doubling: duplicación de prefijos con counting sort, O(n log n)
+// - SAIS: ordenamiento inducido (Nong, Zhang y Chan 2009), O(n)
+// - Parallel: refinamiento de grupos por duplicación en varios hilos
+enum class SuffixArrayAlgorithm { Doubling, SAIS, Parallel };
+
+// CompactLcp - LCP Array con un byte por entrada
+//
+// Los valores menores que 255 se guardan directamente; los demás se marcan
+// con 255 y se buscan en una tabla aparte ordenada por posición. En textos
+// naturales casi todos los LCP son cortos, así que ocupa ~n bytes en lugar
+// de los 4n u 8n del arreglo de índices.
+class CompactLcp {
+public:
+  // lcp[i], con el mismo significado que en BasicSuffixArray::lcp()
+  std::size_t operator[](std::size_t i) const {
+    std::uint8_t value = bytes_[i];
+    return value < kEscape ? value : overflow(i);
+  }
+
+  std::size_t size() const { return bytes_.size(); }
+  std::size_t memory_bytes() const;
+
+private:
+  template <typename> friend class BasicSuffixArray;
+  static constexpr std::uint8_t kEscape = 255;
+
+  std::vector<std::uint8_t> bytes_;
+  // (i, lcp[i]) para los valores >= 255, en orden creciente de i
+  std::vector<std::pair<std::size_t, std::size_t>> overflow_;
+
+  std::size_t overflow(std::size_t i) const;
+};
+
+// Resultado de BasicSuffixArray::build_external
+struct ExternalBuildStats {
+  std::size_t blocks = 0; // Bloques ordenados en memoria con SA-IS
+  // Pico de memoria de trabajo propia: bloque, su arreglo y el espacio de
+  // SA-IS o de la mezcla. No incluye las páginas del texto mapeado.
+  std::size_t peak_memory_bytes = 0;
+  std::uint64_t bytes_read = 0;    // Texto y archivos temporales leídos
+  std::uint64_t bytes_written = 0; // Archivos temporales e índice final
+};
+
+// Clase BasicSuffixArray - Estructura de datos para búsqueda eficiente de
+// patrones
 // Un Suffix Array es un arreglo de índices que representa todos los sufijos
 // de una cadena ordenados lexicográficamente. Permite realizar búsquedas de
 // patrones de manera muy eficiente después de un preprocesamiento.
 // Complejidades:
-// - Construcción: O(n log n) usando el algoritmo de duplicación
-// - Búsqueda: O(m log n) donde m es la longitud del patrón
+// - Construcción: O(n) con SA-IS (por defecto) u O(n log n) con duplicación
+// - Búsqueda: O(m log n) donde m es la longitud del patrón, u O(m + log n)
+//   con LCP-LR (build_lcp_lr)
 // - Espacio: O(n) para almacenar el arreglo de sufijos
-class SuffixArray {
+//
+// Index es el tipo con el que se guarda cada posición del arreglo:
+// - int (por defecto): 4n bytes, textos de hasta 2^31 - 1 caracteres
+// - Index40: 5n bytes, textos de hasta 2^39 - 1 caracteres
+// - std::int64_t: 8n bytes, sin límite práctico
+// Un índice más angosto deja más entradas por línea de caché, así que conviene
+// usar el más pequeño en el que quepa el texto (ver fits()).
+template <typename Index = int> class BasicSuffixArray {
 public:
+  using index_type = Index;
+  // Tipo aritmético usado durante la construcción y la búsqueda
+  using value_type = typename IndexTraits<Index>::value_type;
+  using Algorithm = SuffixArrayAlgorithm;
+
   // Constructor: crea el Suffix Array a partir de una cadena
-  // Complejidad: O(n log n)
-  explicit SuffixArray(const std::string &s);
+  // El objeto se queda con el texto: pasarlo con std::move evita la copia.
+  // threads solo se usa con Algorithm::Parallel (0 = núcleos disponibles)
+  // Lanza std::length_error si el texto no cabe en Index
+  // Complejidad: O(n) con SA-IS, O(n log n) con duplicación
+  explicit BasicSuffixArray(std::string s,
+                            Algorithm algorithm = Algorithm::SAIS,
+                            unsigned threads = 0);
+
+  // Construye el Suffix Array sobre un texto ajeno, sin copiarlo: la única
+  // reserva grande es el arreglo. El texto debe seguir vivo y sin cambios
+  // mientras se use el objeto (o cualquiera de sus copias).
+  static BasicSuffixArray borrow(std::string_view text,
+                                 Algorithm algorithm = Algorithm::SAIS,
+                                 unsigned threads = 0);
+
+  // Igual que la anterior, para texto binario
+  static BasicSuffixArray borrow(std::span<const std::uint8_t> bytes,
+                                 Algorithm algorithm = Algorithm::SAIS,
+                                 unsigned threads = 0);
+
+  // Mapea un archivo de texto (mmap) y construye el arreglo sobre él sin
+  // cargarlo en memoria propia. El objeto mantiene vivo el mapeo.
+  // Lanza std::runtime_error si no puede abrir el archivo.
+  static BasicSuffixArray map_text(const std::string &path,
+                                   Algorithm algorithm = Algorithm::SAIS,
+                                   unsigned threads = 0);
+
+  // Guarda el texto y el arreglo en un archivo binario que open() puede
+  // mapear sin copiar. Formato (orden de bytes del equipo):
+  // - cabecera: firma, versión, ancho del índice, tamaño, secciones y
+  //   checksum FNV-1a de todo el contenido
+  // - texto, arreglo de sufijos y, si include_lcp, el LCP Array de Kasai,
+  //   cada sección alineada a 8 bytes
+  // LCP-LR y la tabla de buckets no se guardan: se reconstruyen en O(n).
+  // Lanza std::runtime_error si no puede escribir el archivo.
+  void save(const std::string &path, bool include_lcp = false) const;
+
+  // Abre un índice guardado con save() mapeándolo en memoria (mmap): no se
+  // copia ni se reconstruye nada, las páginas se leen bajo demanda y se
+  // comparten entre procesos. Con verify = true se recalcula el checksum, lo
+  // que sí recorre todo el archivo.
+  // Lanza std::runtime_error si el archivo no es válido o su ancho de índice
+  // no coincide con Index.
+  static BasicSuffixArray open(const std::string &path, bool verify = false);
+
+  // Construcción en memoria externa, para textos cuyo arreglo no cabe en
+  // RAM. Escribe en index_path el mismo archivo que save() (sin LCP), listo
+  // para open(), con memoria de trabajo acotada por memory_budget:
+  // 1. El texto se parte en bloques de ~memory_budget / (6 + 4 *
+  //    sizeof(value_type)) caracteres, que se procesan del último al primero
+  // 2. Cada bloque se ordena en memoria con SA-IS, usando un bit por
+  //    posición que dice si el sufijo es mayor que el primero de la cola ya
+  //    procesada; el bit se calcula con el algoritmo Z contra el bloque
+  //    anterior y se guarda en un archivo en scratch_dir
+  // 3. El arreglo del bloque se intercala con el de la cola contando, por
+  //    búsqueda hacia atrás sobre la BWT del bloque, cuántos sufijos de la
+  //    cola caen entre cada par de filas
+  // Cada paso lee el texto desde el bloque hasta el final y los archivos de
+  // la cola, siempre en orden, así que el coste no depende de lo repetitivo
+  // que sea el texto: O(n^2 / b) bytes de E/S y O(n^2 / b * log sigma)
+  // tiempo en total con b caracteres por bloque.
+  // Lanza std::invalid_argument si memory_budget es menor que 64 KB,
+  // std::length_error si el texto no cabe en Index y std::runtime_error si
+  // falla la lectura o la escritura.
+  static ExternalBuildStats build_external(const std::string &text_path,
+                                           const std::string &index_path,
+                                           std::size_t memory_budget,
+                                           const std::string &scratch_dir = ".");
 
   // Obtiene el arreglo de sufijos construido
-  const std::vector<int> &sa() const;
+  std::span<const Index> sa() const;
+
+  // LCP Array: lcp[i] = prefijo común más largo entre sa[i-1] y sa[i]
+  // Se calcula con Kasai la primera vez que se pide y queda guardado junto
+  // con inverse_sa(); si el índice se abrió de un archivo con LCP, se usa
+  // ese. Seguro de llamar desde varios hilos.
+  // Complejidad: O(n) la primera vez, O(1) después. Memoria: 2n índices.
+  std::span<const Index> lcp() const;
+
+  // Arreglo inverso: inverse_sa()[sa[i]] = i (rango de cada sufijo)
+  // Se calcula una vez y queda guardado. Seguro desde varios hilos.
+  std::span<const Index> inverse_sa() const;
+
+  // Variante del LCP de bajo consumo: algoritmo Φ (PLCP en orden de texto)
+  // sobre un único arreglo temporal, guardado con un byte por entrada. No
+  // construye ni conserva inverse_sa(): en memoria queda ~n bytes en lugar
+  // de 8n bytes (LCP + inverso) con índices de 32 bits.
+  // Se calcula una vez y queda guardado. Seguro desde varios hilos.
+  // Complejidad: O(n)
+  const CompactLcp &compact_lcp() const;
+
+  // Obtiene el texto indexado
+  std::string_view text() const;
+
+  // Objeto que mantiene vivos text() y sa() (la copia propia o el archivo
+  // mapeado). Quien guarde vistas sobre ellos más allá de la vida de este
+  // objeto puede conservarlo.
+  std::shared_ptr<const void> keepalive() const;
 
   // Obtiene el tamaño de la cadena
-  int n() const;
+  std::size_t n() const;
 
   // Busca un patrón en la cadena usando búsqueda binaria
   // Complejidad: O(m log n) donde m es la longitud del patrón
-  bool search(const std::string &pattern) const;
+  bool search(std::string_view pattern) const;
+
+  // Rango [lo, hi) de sa() con todos los sufijos que empiezan con el patrón
+  // Se obtiene con dos búsquedas binarias (límite inferior y superior)
+  // Complejidad: O(m log n)
+  std::pair<std::size_t, std::size_t>
+  equal_range(std::string_view pattern) const;
+
+  // Número de ocurrencias del patrón, sin recorrerlas
+  // Complejidad: O(m log n)
+  std::size_t count(std::string_view pattern) const;
 
-  // Construye el Suffix Array usando el algoritmo de duplicación (doubling)
+  // Ocurrencias del patrón como vista sobre sa(), sin reservar memoria
+  // Las posiciones aparecen en orden lexicográfico de sufijo, no de texto
+  // Complejidad: O(m log n)
+  std::span<const Index> occurrences(std::string_view pattern) const;
+
+  // Posiciones de todas las ocurrencias del patrón en orden creciente, igual
+  // que KMP::search y BoyerMoore::search
+  // Complejidad: O(m log n + occ log occ)
+  std::vector<value_type> locate(std::string_view pattern) const;
+
+  // Busca muchos patrones a la vez y devuelve el rango [lo, hi) de cada uno
+  // en el orden de entrada (hi - lo es el número de ocurrencias).
+  // Los patrones se ordenan: si una consulta anterior es prefijo de la
+  // actual, la búsqueda se limita a su rango y empieza a comparar después de
+  // ese prefijo. Los patrones ordenados se reparten en bloques entre hilos.
+  // threads = 0 usa todos los núcleos disponibles.
+  std::vector<std::pair<std::size_t, std::size_t>>
+  search_batch(std::span<const std::string_view> patterns,
+               unsigned threads = 0) const;
+
+  // Igual que la anterior, reutilizando un pool de hilos existente
+  std::vector<std::pair<std::size_t, std::size_t>>
+  search_batch(std::span<const std::string_view> patterns,
+               ThreadPool &pool) const;
+
+  // Precalcula la información LCP-LR (Manber-Myers) junto a sa(): para cada
+  // punto medio de la búsqueda binaria guarda el LCP con sus extremos
+  // izquierdo y derecho. A partir de aquí search/equal_range/count/locate
+  // no vuelven a comparar caracteres ya emparejados.
+  // Memoria adicional: 2n índices. Llamar antes de buscar desde varios hilos.
+  // Complejidad: O(n); búsquedas posteriores en O(m + log n)
+  void build_lcp_lr();
+
+  // Indica si las búsquedas usan LCP-LR
+  bool has_lcp_lr() const;
+
+  // Construye una tabla de buckets indexada por los primeros k bytes
+  // (k = 1, 2 o 3): para cada prefijo de k bytes guarda dónde empieza su
+  // bloque en sa(). Los patrones de al menos k caracteres empiezan la
+  // búsqueda binaria dentro de ese bloque, ya con k caracteres emparejados,
+  // en lugar de saltar por todo el arreglo. Ocupa (256^k + 1) índices:
+  // 1 KB, 256 KB o 64 MB con índices de 32 bits.
+  // Lanza std::invalid_argument si k no está entre 1 y 3.
+  // Complejidad: O(n + 256^k)
+  void build_prefix_table(unsigned k = 2);
+
+  // Indica si hay tabla de buckets y su tamaño en bytes
+  bool has_prefix_table() const;
+  std::size_t prefix_table_bytes() const;
+
+  // Indica si un texto de n caracteres puede indexarse con este tipo
+  static bool fits(std::size_t n);
+
+  // Construye el LCP Array con el algoritmo de Kasai
+  // lcp[i] = prefijo común más largo entre los sufijos sa[i-1] y sa[i]
+  // Complejidad: O(n)
+  static std::vector<Index> build_lcp(std::string_view s,
+                                      std::span<const Index> sa);
+
+  // Construye el Suffix Array con el algoritmo indicado
   // Este es un método estático que puede usarse independientemente
+  static std::vector<Index> build_sa(std::string_view s,
+                                     Algorithm algorithm = Algorithm::SAIS,
+                                     unsigned threads = 0);
+
+  // Igual que la anterior, pero escribe el resultado en un búfer del
+  // llamador (por ejemplo, un archivo mapeado) de exactamente s.size()
+  // posiciones. Con SA-IS e índices nativos el arreglo se induce
+  // directamente en out, sin una copia intermedia.
+  // Lanza std::invalid_argument si el tamaño de out no coincide.
+  static void build_sa(std::string_view s, std::span<Index> out,
+                       Algorithm algorithm = Algorithm::SAIS,
+                       unsigned threads = 0);
+
+  // Construcción por duplicación de prefijos (prefix doubling)
   // Complejidad: O(n log n)
-  static std::vector<int> build_sa(const std::string &s);
+  static std::vector<Index> build_sa_doubling(std::string_view s);
+
+  // Construcción por ordenamiento inducido (SA-IS)
+  // Complejidad: O(n) tiempo, O(n) espacio adicional
+  static std::vector<Index> build_sa_sais(std::string_view s);
+
+  // SA-IS sobre un alfabeto entero [0, upper], por ejemplo varios textos
+  // unidos con un separador distinto para cada uno
+  // Complejidad: O(n + upper)
+  static std::vector<Index>
+  build_sa_sais(std::span<const std::uint32_t> symbols, std::uint32_t upper);
+
+  // LCP Array (Kasai) de una secuencia de símbolos enteros y su arreglo
+  static std::vector<Index> build_lcp(std::span<const std::uint32_t> symbols,
+                                      std::span<const Index> sa);
+
+  // Construcción paralela con el número de hilos indicado (0 = núcleos
+  // disponibles). Ordena por los primeros 7 caracteres y luego refina, en
+  // paralelo, solo los grupos de sufijos aún empatados duplicando la
+  // profundidad en cada ronda (Larsson-Sadakane).
+  // Complejidad: O(n log² n) trabajo total repartido entre los hilos
+  static std::vector<Index> build_sa_parallel(std::string_view s,
+                                              unsigned threads = 0);
 
 private:
-  std::string s_;       // Cadena original
-  std::vector<int> sa_; // Arreglo de sufijos (índices ordenados)
+  // Datos construidos en memoria: el arreglo y, si el objeto es dueño del
+  // texto, su copia. Con borrow/map_text text queda vacío y text_owner
+  // mantiene vivo el origen cuando es un archivo mapeado.
+  struct OwnedStorage {
+    std::string text;
+    std::vector<Index> sa;
+    std::shared_ptr<const void> text_owner;
+  };
+
+  // Construye el arreglo sobre s_ y lo guarda en storage
+  void build_owned(std::shared_ptr<OwnedStorage> storage, Algorithm algorithm,
+                   unsigned threads);
+
+  BasicSuffixArray() = default;
+
+  // Mantiene vivos los datos a los que apuntan las vistas: OwnedStorage o el
+  // índice mapeado. Las copias del objeto comparten los mismos datos.
+  std::shared_ptr<const void> storage_;
+  std::string_view s_;         // Cadena original
+  std::span<const Index> sa_;  // Arreglo de sufijos (índices ordenados)
+  std::span<const Index> lcp_; // LCP guardado en el archivo, si lo hay
+
+  // Arreglos derivados que se calculan al pedirlos por primera vez. Se
+  // comparten entre copias, igual que los datos de storage_.
+  struct LazyArrays {
+    std::once_flag inverse_once, lcp_once, compact_once;
+    std::vector<Index> inverse_sa;
+    std::vector<Index> lcp;
+    CompactLcp compact_lcp;
+  };
+  std::shared_ptr<LazyArrays> lazy_ = std::make_shared<LazyArrays>();
+
+  // LCP-LR: para el punto medio M de cada intervalo [L, R] que visita la
+  // búsqueda binaria, LCP(sa[L], sa[M]) y LCP(sa[M], sa[R]). Vacíos si no se
+  // llamó a build_lcp_lr().
+  std::vector<Index> lcp_left_;
+  std::vector<Index> lcp_right_;
+
+  // Tabla de buckets: prefix_table_[K] = número de sufijos menores que la
+  // cadena de k bytes K (vacía si no se llamó a build_prefix_table)
+  unsigned prefix_k_ = 0;
+  std::vector<Index> prefix_table_;
+
+  // Compara el sufijo que empieza en pos con el patrón, desde el carácter
+  // offset (los anteriores ya se saben iguales). Devuelve < 0 si el sufijo es
+  // menor, 0 si el patrón es prefijo del sufijo y > 0 si es mayor.
+  // Si matched no es nulo, guarda cuántos caracteres del patrón coinciden.
+  int compare_suffix(std::size_t pos, std::string_view pattern,
+                     std::size_t offset = 0,
+                     std::size_t *matched = nullptr) const;
+
+  // Límite inferior o superior usando LCP-LR (mismo contrato que bound)
+  std::size_t bound_lcp_lr(std::string_view pattern, bool upper) const;
+
+  // Rango inicial de búsqueda para un patrón: el bucket de sus primeros k
+  // bytes si hay tabla y el patrón es suficientemente largo, o todo sa().
+  // Devuelve {lo, hi, caracteres ya emparejados}.
+  struct SearchRange {
+    std::size_t lo, hi, matched;
+  };
+  SearchRange root_range(std::string_view pattern) const;
+
+  // Primera posición de sa() en [lo, hi) cuyo sufijo no es menor que el
+  // patrón (upper = false) o es mayor que él (upper = true). Todos los
+  // sufijos del rango deben compartir los primeros offset caracteres.
+  std::size_t bound(std::string_view pattern, std::size_t lo, std::size_t hi,
+                    bool upper, std::size_t offset = 0) const;
 };
 
-#endif // UNTITLED_SUFFIXARRAY_H
\ No newline at end of file
+// Instancias compiladas en SuffixArray.cpp
+extern template class BasicSuffixArray<int>;
+extern template class BasicSuffixArray<Index40>;
+extern template class BasicSuffixArray<std::int64_t>;
+
+// Alias por ancho de índice; SuffixArray (32 bits) es el caso habitual
+using SuffixArray = BasicSuffixArray<int>;
+using SuffixArray40 = BasicSuffixArray<Index40>;
+using SuffixArray64 = BasicSuffixArray<std::int64_t>;
+
+#endif // UNTITLED_SUFFIXARRAY_H
@@ -0,0 +1,151 @@
+#include "SuffixCompare.h"
+#include <atomic>
+
+// Los núcleos SIMD se compilan con el atributo target, así que no hace falta
+// compilar todo el programa con -mavx2: solo se llaman si la CPU los admite
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SUFFIXCOMPARE_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+using MismatchFn = std::size_t (*)(const char *, const char *, std::size_t);
+
+std::size_t mismatch_scalar(const char *a, const char *b, std::size_t length) {
+  std::size_t i = 0;
+  while (i < length && a[i] == b[i])
+    i++;
+  return i;
+}
+
+#ifdef SUFFIXCOMPARE_X86
+
+// movemask da un bit por byte igual; el primer 0 es el primer byte distinto
+__attribute__((target("sse2"))) std::size_t
+mismatch_sse2(const char *a, const char *b, std::size_t length) {
+  std::size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+    __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+    unsigned differ =
+        static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))) ^
+        0xffffu;
+    if (differ != 0)
+      return i + static_cast<std::size_t>(__builtin_ctz(differ));
+  }
+  return i + mismatch_scalar(a + i, b + i, length - i);
+}
+
+// Bloques de 32 bytes y una cola de 16. La cola se compara aquí mismo y no
+// en mismatch_sse2: mezclar código SSE sin VEX con registros AVX a medio
+// usar cuesta una transición de estado en cada llamada.
+__attribute__((target("avx2"))) std::size_t
+mismatch_avx2(const char *a, const char *b, std::size_t length) {
+  std::size_t i = 0;
+  for (; i + 32 <= length; i += 32) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+    __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+    unsigned differ =
+        ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+    if (differ != 0)
+      return i + static_cast<std::size_t>(__builtin_ctz(differ));
+  }
+  if (i + 16 <= length) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+    __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+    unsigned differ =
+        static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))) ^
+        0xffffu;
+    if (differ != 0)
+      return i + static_cast<std::size_t>(__builtin_ctz(differ));
+    i += 16;
+  }
+  return i + mismatch_scalar(a + i, b + i, length - i);
+}
+
+#endif
+
+MismatchFn kernel_function(SuffixCompare::Kernel kernel) {
+#ifdef SUFFIXCOMPARE_X86
+  if (kernel == SuffixCompare::Kernel::AVX2)
+    return mismatch_avx2;
+  if (kernel == SuffixCompare::Kernel::SSE2)
+    return mismatch_sse2;
+#endif
+  (void)kernel;
+  return mismatch_scalar;
+}
+
+// El mejor núcleo que admite la CPU
+SuffixCompare::Kernel detect() {
+  if (SuffixCompare::supported(SuffixCompare::Kernel::AVX2))
+    return SuffixCompare::Kernel::AVX2;
+  if (SuffixCompare::supported(SuffixCompare::Kernel::SSE2))
+    return SuffixCompare::Kernel::SSE2;
+  return SuffixCompare::Kernel::Scalar;
+}
+
+// Núcleo en uso. Atómico para que set_kernel no sea una carrera con otros
+// hilos que comparan; la lectura relajada no cuesta más que una normal.
+// Empieza en el escalar (inicialización constante), así que es válido aun
+// antes de que se ejecute la detección.
+std::atomic<SuffixCompare::Kernel> current_kernel{
+    SuffixCompare::Kernel::Scalar};
+std::atomic<MismatchFn> current_function{mismatch_scalar};
+
+// Elige el mejor núcleo al iniciar el programa
+const bool kernel_detected = SuffixCompare::set_kernel(detect());
+
+} // namespace
+
+std::size_t SuffixCompare::dispatch(const char *a, const char *b,
+                                    std::size_t length) {
+  return current_function.load(std::memory_order_relaxed)(a, b, length);
+}
+
+int SuffixCompare::compare(const char *a, const char *b, std::size_t length,
+                           std::size_t *offset) {
+  std::size_t i = mismatch(a, b, length);
+  if (offset)
+    *offset = i;
+  if (i == length)
+    return 0;
+  return static_cast<unsigned char>(a[i]) < static_cast<unsigned char>(b[i])
+             ? -1
+             : 1;
+}
+
+SuffixCompare::Kernel SuffixCompare::kernel() {
+  return current_kernel.load(std::memory_order_relaxed);
+}
+
+const char *SuffixCompare::name(Kernel kernel) {
+  switch (kernel) {
+  case Kernel::AVX2:
+    return "AVX2";
+  case Kernel::SSE2:
+    return "SSE2";
+  default:
+    return "Scalar";
+  }
+}
+
+bool SuffixCompare::supported(Kernel kernel) {
+#ifdef SUFFIXCOMPARE_X86
+  __builtin_cpu_init();
+  if (kernel == Kernel::AVX2)
+    return __builtin_cpu_supports("avx2");
+  if (kernel == Kernel::SSE2)
+    return __builtin_cpu_supports("sse2");
+#endif
+  return kernel == Kernel::Scalar;
+}
+
+bool SuffixCompare::set_kernel(Kernel kernel) {
+  if (!supported(kernel))
+    return false;
+  current_function.store(kernel_function(kernel), std::memory_order_relaxed);
+  current_kernel.store(kernel, std::memory_order_relaxed);
+  return true;
+}
@@ -0,0 +1,58 @@
+#ifndef SUFFIXCOMPARE_H
+#define SUFFIXCOMPARE_H
+
+#pragma once
+#include <cstddef>
+
+// Clase SuffixCompare - Primer byte distinto entre dos cadenas, por bloques
+//
+// Es el núcleo común de la búsqueda (comparar el patrón con un sufijo) y del
+// LCP (Kasai y Φ extienden el prefijo común de dos sufijos). En lugar de
+// comparar byte a byte, compara 16 (SSE2) o 32 (AVX2) bytes por instrucción
+// y localiza el primer byte distinto con la máscara de la comparación. El
+// núcleo se elige al iniciar el programa según la CPU; sin SIMD (u otra
+// arquitectura) se usa el bucle escalar.
+// Los primeros bytes se comparan en línea, sin llamar al núcleo: en textos
+// naturales la mayoría de las comparaciones terminan ahí.
+class SuffixCompare {
+public:
+  enum class Kernel { Scalar, SSE2, AVX2 };
+
+  // Desplazamiento del primer byte distinto entre a[0..length) y
+  // b[0..length), o length si son iguales
+  // Complejidad: O(length / ancho del bloque)
+  static std::size_t mismatch(const char *a, const char *b,
+                              std::size_t length) {
+    std::size_t i = 0;
+    for (; i < length && i < kInlineBytes; ++i)
+      if (a[i] != b[i])
+        return i;
+    return i == length ? i : i + dispatch(a + i, b + i, length - i);
+  }
+
+  // Compara a[0..length) con b[0..length) como bytes sin signo: < 0, 0 o
+  // > 0, igual que memcmp. Si offset no es nulo, guarda el primer
+  // desplazamiento distinto (o length).
+  static int compare(const char *a, const char *b, std::size_t length,
+                     std::size_t *offset = nullptr);
+
+  // Núcleo en uso y su nombre
+  static Kernel kernel();
+  static const char *name(Kernel kernel);
+
+  // Indica si la CPU admite el núcleo
+  static bool supported(Kernel kernel);
+
+  // Cambia el núcleo en uso (para medir o probar uno en particular).
+  // Devuelve false y no cambia nada si la CPU no lo admite.
+  static bool set_kernel(Kernel kernel);
+
+private:
+  static constexpr std::size_t kInlineBytes = 8;
+
+  // Llama al núcleo elegido
+  static std::size_t dispatch(const char *a, const char *b,
+                              std::size_t length);
+};
+
+#endif // SUFFIXCOMPARE_H
@@ -3,14 +3,188 @@
 //
 
 #include "SuffixTree.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
 
-SuffixTree::SuffixTree(const std::string& s) : text_(s) {
-    build();
+// El árbol vacío solo tiene la raíz (nodo 0)
+SuffixTree::SuffixTree()
+    : edge_keys_(16, kEmptyKey), edge_children_(16, kNone) {
+  new_node(kNone, kNone);
 }
 
-void SuffixTree::build() {
+// Construcción de Ukkonen: una fase por carácter
+SuffixTree::SuffixTree(const std::string &s) : SuffixTree() {
+  nodes_.reserve(2 * s.size() + 1);
+  append(s);
 }
 
-bool SuffixTree::search(const std::string& pattern) const {
-    return text_.find(pattern) != std::string::npos;
+// Cada carácter nuevo es una fase más de Ukkonen sobre el mismo punto activo:
+// el árbol queda igual que si se hubiera construido con todo el texto
+void SuffixTree::append(std::string_view data) {
+  if (data.size() >
+      static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()) -
+          text_.size())
+    throw std::length_error("SuffixTree: texto demasiado grande");
+  std::size_t begin = text_.size();
+  text_.append(data);
+  for (std::size_t i = begin; i < text_.size(); ++i)
+    extend(static_cast<std::int32_t>(i));
+}
+
+// Una fase de Ukkonen
+// - Regla 1: todas las hojas crecen a la vez al mover el final global
+// - Regla 2: si el carácter no sigue al punto activo se crea una hoja (y, a
+//   mitad de una arista, un nodo interno que la parte)
+// - Regla 3: si ya sigue, el punto activo avanza y la fase termina
+// remainder_ cuenta los sufijos que faltan por hacer explícitos; tras crear
+// una hoja, el punto activo salta por el enlace de sufijo (o se acorta en la
+// raíz) hacia el siguiente sufijo más corto.
+void SuffixTree::extend(std::int32_t position) {
+  end_ = position + 1;
+  remainder_++;
+  std::int32_t last_internal = kNone; // Espera su enlace de sufijo
+  unsigned char current = static_cast<unsigned char>(text_[position]);
+
+  while (remainder_ > 0) {
+    if (active_length_ == 0)
+      active_edge_ = position;
+    unsigned char first = static_cast<unsigned char>(text_[active_edge_]);
+    std::int32_t next = child(active_node_, first);
+
+    if (next == kNone) {
+      set_child(active_node_, first, new_node(position, kLeafEnd));
+      if (last_internal != kNone)
+        nodes_[last_internal].link = active_node_;
+      last_internal = kNone;
+    } else {
+      // Descenso: el punto activo pasa de largo la arista completa
+      std::int32_t length = edge_length(next);
+      if (active_length_ >= length) {
+        active_edge_ += length;
+        active_length_ -= length;
+        active_node_ = next;
+        continue;
+      }
+
+      // Regla 3: el carácter ya está en la arista
+      std::int32_t start = nodes_[next].start;
+      if (static_cast<unsigned char>(text_[start + active_length_]) ==
+          current) {
+        if (last_internal != kNone)
+          nodes_[last_internal].link = active_node_;
+        active_length_++;
+        break;
+      }
+
+      // Regla 2 a mitad de arista: se parte la arista con un nodo interno
+      std::int32_t split = new_node(start, start + active_length_);
+      set_child(active_node_, first, split);
+      set_child(split, current, new_node(position, kLeafEnd));
+      nodes_[next].start += active_length_;
+      set_child(split,
+                static_cast<unsigned char>(text_[nodes_[next].start]), next);
+      if (last_internal != kNone)
+        nodes_[last_internal].link = split;
+      last_internal = split;
+    }
+
+    remainder_--;
+    if (active_node_ == 0 && active_length_ > 0) {
+      active_length_--;
+      active_edge_ = position - remainder_ + 1;
+    } else if (active_node_ != 0) {
+      active_node_ = nodes_[active_node_].link;
+    }
+  }
+}
+
+// Camino desde la raíz comparando el patrón con las etiquetas de las aristas
+bool SuffixTree::search(std::string_view pattern) const {
+  std::int32_t node = 0;
+  std::size_t matched = 0;
+  while (matched < pattern.size()) {
+    node = child(node, static_cast<unsigned char>(pattern[matched]));
+    if (node == kNone)
+      return false;
+    std::int32_t start = nodes_[node].start;
+    std::size_t length = static_cast<std::size_t>(edge_length(node));
+    std::size_t compare = std::min(length, pattern.size() - matched);
+    if (std::string_view(text_).substr(start, compare) !=
+        pattern.substr(matched, compare))
+      return false;
+    matched += compare;
+  }
+  return true;
+}
+
+std::size_t SuffixTree::size() const { return text_.size(); }
+
+std::size_t SuffixTree::node_count() const { return nodes_.size(); }
+
+std::size_t SuffixTree::memory_bytes() const {
+  return text_.capacity() + nodes_.capacity() * sizeof(Node) +
+         edge_keys_.capacity() * sizeof(std::uint64_t) +
+         edge_children_.capacity() * sizeof(std::int32_t);
+}
+
+// Los nodos nuevos enlazan a la raíz hasta que se conoce su enlace
+std::int32_t SuffixTree::new_node(std::int32_t start, std::int32_t end) {
+  nodes_.push_back({start, end, 0});
+  return static_cast<std::int32_t>(nodes_.size() - 1);
+}
+
+std::int32_t SuffixTree::edge_end(std::int32_t node) const {
+  return nodes_[node].end == kLeafEnd ? end_ : nodes_[node].end;
+}
+
+std::int32_t SuffixTree::edge_length(std::int32_t node) const {
+  return edge_end(node) - nodes_[node].start;
+}
+
+// Sondeo lineal desde la posición que da el hash de la clave: termina en la
+// clave buscada o en una casilla vacía
+std::size_t SuffixTree::slot_of(std::uint64_t key) const {
+  std::size_t mask = edge_keys_.size() - 1;
+  std::size_t slot =
+      static_cast<std::size_t>((key * 0x9e3779b97f4a7c15ULL) >> 20) & mask;
+  while (edge_keys_[slot] != kEmptyKey && edge_keys_[slot] != key)
+    slot = (slot + 1) & mask;
+  return slot;
+}
+
+std::int32_t SuffixTree::child(std::int32_t node, unsigned char c) const {
+  std::uint64_t key = static_cast<std::uint64_t>(node) << 8 | c;
+  std::size_t slot = slot_of(key);
+  return edge_keys_[slot] == key ? edge_children_[slot] : kNone;
+}
+
+void SuffixTree::set_child(std::int32_t node, unsigned char c,
+                           std::int32_t child) {
+  std::uint64_t key = static_cast<std::uint64_t>(node) << 8 | c;
+  std::size_t slot = slot_of(key);
+  if (edge_keys_[slot] != key) {
+    if ((edge_count_ + 1) * 10 > edge_keys_.size() * 7) {
+      grow_edges();
+      slot = slot_of(key);
+    }
+    edge_keys_[slot] = key;
+    edge_count_++;
+  }
+  edge_children_[slot] = child;
+}
+
+// Duplica la tabla y reinserta todas las aristas
+void SuffixTree::grow_edges() {
+  std::vector<std::uint64_t> keys(edge_keys_.size() * 2, kEmptyKey);
+  std::vector<std::int32_t> children(keys.size(), kNone);
+  keys.swap(edge_keys_);
+  children.swap(edge_children_);
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    if (keys[i] == kEmptyKey)
+      continue;
+    std::size_t slot = slot_of(keys[i]);
+    edge_keys_[slot] = keys[i];
+    edge_children_[slot] = children[i];
+  }
 }
@@ -5,30 +5,98 @@
 #ifndef UNTITLED_SUFFIXTREE_H
 #define UNTITLED_SUFFIXTREE_H
 
-
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <string>
-#include <map>
-#include <memory>
+#include <string_view>
+#include <vector>
 
+// Clase SuffixTree - Árbol de sufijos con la construcción en línea de
+// Ukkonen
+//
+// Se construye carácter a carácter en O(n) amortizado. El árbol es implícito
+// (no se agrega terminador): todo sufijo es un camino desde la raíz, aunque
+// algunos terminen a mitad de una arista, lo que basta para buscar
+// subcadenas. Por eso admite agregar texto al final en cualquier momento
+// (append), sin reconstruir: sirve como índice de flujos que solo crecen,
+// como registros.
+//
+// Representación:
+// - Los nodos viven en un arreglo contiguo y se referencian por índice
+// - Cada arista guarda [start, end) sobre el texto; las hojas usan un único
+//   final global, así que extender todas las hojas cuesta O(1)
+// - Los hijos están en una tabla hash de direccionamiento abierto compartida
+//   por todo el árbol, indexada por (nodo, primer carácter)
 class SuffixTree {
 public:
-    explicit SuffixTree(const std::string& s);
-    bool search(const std::string& pattern) const;
+  // Árbol vacío, para llenarlo con append
+  SuffixTree();
+
+  explicit SuffixTree(const std::string &s);
+
+  // Agrega texto al final y extiende el árbol; las búsquedas posteriores
+  // cubren todo el texto agregado hasta ahora
+  // Lanza std::length_error si el total supera 2^31 - 1 caracteres
+  // Complejidad: O(k) amortizado para k caracteres
+  void append(std::string_view data);
+
+  // Indica si el patrón aparece en el texto
+  // Complejidad: O(m)
+  bool search(std::string_view pattern) const;
+
+  // Obtiene el tamaño del texto
+  std::size_t size() const;
+
+  // Número de nodos (raíz, internos y hojas)
+  std::size_t node_count() const;
+
+  // Memoria reservada por el árbol en bytes: texto, nodos y tabla de aristas
+  std::size_t memory_bytes() const;
 
 private:
-    struct Node {
-        std::map<char, std::unique_ptr<Node>> children;
-        int start;
-        int* end;
-        Node* suffix_link;
-    };
-
-    std::string text_;
-    std::unique_ptr<Node> root_;
-    void build();
-};
+  // Final de arista de las hojas: se lee del final global end_
+  static constexpr std::int32_t kLeafEnd = -1;
+  static constexpr std::int32_t kNone = -1;
+
+  struct Node {
+    std::int32_t start; // Inicio de la arista que llega al nodo
+    std::int32_t end;   // Final (exclusivo) de la arista, o kLeafEnd
+    std::int32_t link;  // Enlace de sufijo (nodos internos)
+  };
+
+  // Tabla de aristas: clave (nodo << 8 | carácter) -> hijo, con sondeo
+  // lineal. Capacidad potencia de dos, carga máxima 0.7.
+  static constexpr std::uint64_t kEmptyKey = ~std::uint64_t(0);
+  std::vector<std::uint64_t> edge_keys_;
+  std::vector<std::int32_t> edge_children_;
+  std::size_t edge_count_ = 0;
+
+  std::string text_;
+  std::vector<Node> nodes_;
+  std::int32_t end_ = 0; // Final global de las hojas
+
+  // Punto activo de Ukkonen: dónde continúa la próxima extensión
+  std::int32_t active_node_ = 0;
+  std::int32_t active_edge_ = 0; // Posición del texto con el primer carácter
+  std::int32_t active_length_ = 0;
+  std::int32_t remainder_ = 0; // Sufijos pendientes de insertar
 
+  // Agrega text_[position] al árbol (una fase de Ukkonen)
+  void extend(std::int32_t position);
 
+  std::int32_t new_node(std::int32_t start, std::int32_t end);
+  std::int32_t edge_end(std::int32_t node) const;
+  std::int32_t edge_length(std::int32_t node) const;
+
+  // Hijo de node cuya arista empieza con c, o kNone
+  std::int32_t child(std::int32_t node, unsigned char c) const;
+
+  // Asigna (o reemplaza) el hijo de node cuya arista empieza con c
+  void set_child(std::int32_t node, unsigned char c, std::int32_t child);
+
+  std::size_t slot_of(std::uint64_t key) const;
+  void grow_edges();
+};
 
-#endif //UNTITLED_SUFFIXTREE_H
\ No newline at end of file
+#endif // UNTITLED_SUFFIXTREE_H
@@ -0,0 +1,77 @@
+#include "ThreadPool.h"
+
+// Constructor: lanza threads - 1 hilos de trabajo; el hilo que llama a
+// parallel_for completa el total
+ThreadPool::ThreadPool(unsigned threads) {
+  if (threads == 0)
+    threads = default_threads();
+  for (unsigned i = 1; i < threads; ++i)
+    workers_.emplace_back(&ThreadPool::worker_loop, this);
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  start_cv_.notify_all();
+  for (auto &worker : workers_)
+    worker.join();
+}
+
+unsigned ThreadPool::size() const {
+  return static_cast<unsigned>(workers_.size()) + 1;
+}
+
+unsigned ThreadPool::default_threads() {
+  unsigned hw = std::thread::hardware_concurrency();
+  return hw == 0 ? 1 : hw;
+}
+
+// Reparte las tareas una a una: las tareas largas no bloquean a las demás
+void ThreadPool::parallel_for(size_t count,
+                              const std::function<void(size_t)> &task) {
+  if (count == 0)
+    return;
+  if (workers_.empty() || count == 1) {
+    for (size_t i = 0; i < count; ++i)
+      task(i);
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  task_ = &task;
+  count_ = count;
+  next_ = 0;
+  pending_ = count;
+  ++generation_;
+  start_cv_.notify_all();
+
+  run_tasks(lock);
+  done_cv_.wait(lock, [this] { return pending_ == 0; });
+  task_ = nullptr;
+}
+
+void ThreadPool::run_tasks(std::unique_lock<std::mutex> &lock) {
+  while (next_ < count_) {
+    size_t i = next_++;
+    const auto *task = task_;
+    lock.unlock();
+    (*task)(i);
+    lock.lock();
+    if (--pending_ == 0)
+      done_cv_.notify_all();
+  }
+}
+
+void ThreadPool::worker_loop() {
+  unsigned long seen = 0;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    start_cv_.wait(lock, [&] { return stop_ || generation_ != seen; });
+    if (stop_)
+      return;
+    seen = generation_;
+    run_tasks(lock);
+  }
+}
@@ -0,0 +1,54 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Clase ThreadPool - Conjunto fijo de hilos para paralelismo de datos
+//
+// Los hilos se crean una sola vez y se reutilizan en cada llamada a
+// parallel_for, evitando el costo de crear hilos en algoritmos que ejecutan
+// muchas fases cortas (por ejemplo, cada ronda de la construcción paralela del
+// Suffix Array). El hilo que llama también ejecuta tareas.
+class ThreadPool {
+public:
+  // Crea el pool con el número de hilos indicado (0 = núcleos disponibles)
+  explicit ThreadPool(unsigned threads = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  // Número total de hilos que ejecutan tareas (incluye al hilo que llama)
+  unsigned size() const;
+
+  // Ejecuta task(i) para cada i en [0, count) repartiendo las tareas entre los
+  // hilos. Bloquea hasta que todas terminan. No es reentrante.
+  void parallel_for(size_t count, const std::function<void(size_t)> &task);
+
+  // Número de hilos a usar cuando el usuario pide 0 (núcleos disponibles)
+  static unsigned default_threads();
+
+private:
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable start_cv_; // Avisa a los hilos de un nuevo trabajo
+  std::condition_variable done_cv_;  // Avisa al llamador del fin del trabajo
+  const std::function<void(size_t)> *task_ = nullptr;
+  size_t count_ = 0;        // Número de tareas del trabajo actual
+  size_t next_ = 0;         // Siguiente tarea a repartir
+  size_t pending_ = 0;      // Tareas aún no terminadas
+  unsigned long generation_ = 0; // Identificador del trabajo actual
+  bool stop_ = false;
+
+  // Toma y ejecuta tareas del trabajo actual hasta agotarlas
+  void run_tasks(std::unique_lock<std::mutex> &lock);
+  void worker_loop();
+};
+
+#endif // THREADPOOL_H
@@ -0,0 +1,115 @@
+#include "WaveletMatrix.h"
+#include <bit>
+
+RankBitVector::RankBitVector(std::size_t n) : size_(n), words_(n / 64 + 1) {}
+
+void RankBitVector::set(std::size_t i) {
+  words_[i / 64] |= std::uint64_t(1) << (i % 64);
+}
+
+bool RankBitVector::get(std::size_t i) const {
+  return (words_[i / 64] >> (i % 64)) & 1;
+}
+
+// Suma acumulada de unos al inicio de cada bloque de 8 palabras
+void RankBitVector::build() {
+  blocks_.assign(words_.size() / 8 + 1, 0);
+  std::uint64_t total = 0;
+  for (std::size_t w = 0; w < words_.size(); ++w) {
+    if (w % 8 == 0)
+      blocks_[w / 8] = total;
+    total += std::popcount(words_[w]);
+  }
+}
+
+std::size_t RankBitVector::rank1(std::size_t i) const {
+  std::size_t word = i / 64;
+  std::size_t count = blocks_[word / 8];
+  for (std::size_t w = word & ~std::size_t(7); w < word; ++w)
+    count += std::popcount(words_[w]);
+  if (i % 64)
+    count += std::popcount(words_[word] & ((std::uint64_t(1) << (i % 64)) - 1));
+  return count;
+}
+
+std::size_t RankBitVector::memory_bytes() const {
+  return (words_.size() + blocks_.size()) * sizeof(std::uint64_t);
+}
+
+// Construye nivel por nivel: guarda el bit del nivel y reordena de forma
+// estable (ceros primero) para el siguiente
+WaveletMatrix::WaveletMatrix(std::string_view data) : size_(data.size()) {
+  std::vector<unsigned char> current(data.begin(), data.end());
+  std::vector<unsigned char> next(size_);
+  for (int level = 0; level < kLevels; ++level) {
+    int bit = kLevels - 1 - level;
+    RankBitVector bits(size_);
+    std::size_t zeros = 0;
+    for (std::size_t i = 0; i < size_; ++i) {
+      if ((current[i] >> bit) & 1)
+        bits.set(i);
+      else
+        zeros++;
+    }
+    bits.build();
+
+    std::size_t z = 0, o = zeros;
+    for (std::size_t i = 0; i < size_; ++i)
+      next[((current[i] >> bit) & 1) ? o++ : z++] = current[i];
+    current.swap(next);
+
+    levels_[level] = std::move(bits);
+    zeros_[level] = zeros;
+  }
+
+  // El inicio de cada símbolo se obtiene bajando la posición 0 con sus bits
+  for (int c = 0; c < 256; ++c) {
+    std::size_t p = 0;
+    for (int level = 0; level < kLevels; ++level) {
+      if ((c >> (kLevels - 1 - level)) & 1)
+        p = zeros_[level] + levels_[level].rank1(p);
+      else
+        p = levels_[level].rank0(p);
+    }
+    start_[c] = p;
+  }
+}
+
+unsigned char WaveletMatrix::access(std::size_t i) const {
+  return access_rank(i).first;
+}
+
+std::size_t WaveletMatrix::rank(unsigned char c, std::size_t i) const {
+  for (int level = 0; level < kLevels; ++level) {
+    if ((c >> (kLevels - 1 - level)) & 1)
+      i = zeros_[level] + levels_[level].rank1(i);
+    else
+      i = levels_[level].rank0(i);
+  }
+  return i - start_[c];
+}
+
+// Sigue la posición i: el bit de cada nivel reconstruye el símbolo y la
+// posición final, relativa al bloque del símbolo, es su rank
+std::pair<unsigned char, std::size_t>
+WaveletMatrix::access_rank(std::size_t i) const {
+  unsigned c = 0;
+  for (int level = 0; level < kLevels; ++level) {
+    const RankBitVector &bits = levels_[level];
+    if (bits.get(i)) {
+      c = (c << 1) | 1;
+      i = zeros_[level] + bits.rank1(i);
+    } else {
+      c <<= 1;
+      i = bits.rank0(i);
+    }
+  }
+  return {static_cast<unsigned char>(c), i - start_[c]};
+}
+
+std::size_t WaveletMatrix::memory_bytes() const {
+  std::size_t bytes = sizeof(*this);
+  for (const auto &level : levels_)
+    bytes += level.memory_bytes();
+  return bytes;
+}
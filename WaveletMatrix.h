@@ -0,0 +1,78 @@
+#ifndef WAVELETMATRIX_H
+#define WAVELETMATRIX_H
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Clase RankBitVector - Vector de bits con rank en tiempo constante
+//
+// Guarda los bits en palabras de 64 y, cada 512 bits, el número de unos
+// anteriores. rank1(i) suma ese contador y el popcount de a lo sumo 8
+// palabras. Memoria: n bits + 12.5%.
+class RankBitVector {
+public:
+  RankBitVector() = default;
+
+  // Vector de n bits en cero; se llenan con set() y luego se llama a build()
+  explicit RankBitVector(std::size_t n);
+
+  void set(std::size_t i);
+  bool get(std::size_t i) const;
+
+  // Calcula los contadores por bloque. Llamar después del último set()
+  void build();
+
+  // Número de unos (o ceros) en [0, i)
+  std::size_t rank1(std::size_t i) const;
+  std::size_t rank0(std::size_t i) const { return i - rank1(i); }
+
+  std::size_t size() const { return size_; }
+  std::size_t memory_bytes() const;
+
+private:
+  std::size_t size_ = 0;
+  std::vector<std::uint64_t> words_;
+  std::vector<std::uint64_t> blocks_; // Unos antes de cada bloque de 512 bits
+};
+
+// Clase WaveletMatrix - Secuencia de bytes con access y rank por símbolo
+//
+// Un nivel por bit del símbolo (del más significativo al menos): en cada
+// nivel se guarda ese bit de cada elemento y se reordenan de forma estable
+// con los ceros primero. access(i) y rank(c, i) bajan por los 8 niveles con
+// una consulta rank por nivel. Memoria: 8 bits por símbolo + 12.5%, sin
+// punteros ni un vector por nodo como en el wavelet tree clásico.
+class WaveletMatrix {
+public:
+  WaveletMatrix() = default;
+  explicit WaveletMatrix(std::string_view data);
+
+  // Símbolo en la posición i
+  unsigned char access(std::size_t i) const;
+
+  // Apariciones del símbolo c en [0, i)
+  std::size_t rank(unsigned char c, std::size_t i) const;
+
+  // access(i) y rank(access(i), i) en una sola bajada
+  std::pair<unsigned char, std::size_t> access_rank(std::size_t i) const;
+
+  std::size_t size() const { return size_; }
+  std::size_t memory_bytes() const;
+
+private:
+  static constexpr int kLevels = 8;
+
+  std::size_t size_ = 0;
+  std::array<RankBitVector, kLevels> levels_;
+  std::array<std::size_t, kLevels> zeros_{}; // Ceros de cada nivel
+  // Posición donde empieza el bloque de cada símbolo en el último nivel: el
+  // rank de c hasta i es la posición de i al final menos este valor
+  std::array<std::size_t, 256> start_{};
+};
+
+#endif // WAVELETMATRIX_H
@@ -3,6 +3,7 @@
 #include <iomanip>
 #include <iostream>
 #include <string>
+#include <string_view>
 
 using namespace std;
 
@@ -17,7 +18,7 @@ void print_separator(char c = '=', int length = 80) {
 }
 
 // Función para mostrar un fragmento de texto con contexto
-void show_text_preview(const string &text, int max_length = 60) {
+void show_text_preview(string_view text, int max_length = 60) {
   if (text.length() <= max_length) {
     cout << "\"" << text << "\"";
   } else {
@@ -44,7 +45,7 @@ void demo_plagiarism_detection(const string &text1, const string &text2,
   cout << "\nAnalizando con longitud mínima de coincidencia: " << min_length
        << " caracteres..." << endl;
   PlagiarismDetector detector(text1, text2, min_length);
-  PlagiarismDetector::Report report = detector.analyze();
+  const PlagiarismDetector::Report &report = detector.analyze();
 
   // Mostrar resultados
   print_separator('-');
@@ -1,5 +1,9 @@
 #include "Benchmark.h"
+#include "SuffixCompare.h"
+#include "ThreadPool.h"
+#include <algorithm>
 #include <iostream>
+#include <utility>
 
 // Genera un texto aleatorio de n caracteres
 // Usa un alfabeto pequeño (4 letras) para aumentar la probabilidad de
@@ -13,6 +17,20 @@ std::string generate_random_text(size_t n) {
   return text;
 }
 
+// Genera un texto muy repetitivo de n caracteres: un bloque aleatorio de
+// period caracteres que se repite con una mutación cada ~1000 caracteres,
+// como los registros (logs) con plantillas fijas
+std::string generate_repetitive_text(size_t n, size_t period) {
+  std::string block = generate_random_text(period);
+  std::string text;
+  text.reserve(n);
+  while (text.size() < n)
+    text += block.substr(0, std::min(period, n - text.size()));
+  for (size_t i = rand() % 1000; i < n; i += 1 + rand() % 2000)
+    text[i] = 'a' + (rand() % 4);
+  return text;
+}
+
 // Programa principal de benchmarking
 // Compara el desempeño de Suffix Array vs KMP vs Boyer-Moore
 // con diferentes tamaños de texto
@@ -33,5 +51,252 @@ int main() {
     Benchmark::export_csv(results, "results_" + std::to_string(n) + ".csv");
   }
 
+  // Búsqueda lineal sin índice en los mismos tamaños: patrón corto y uno de
+  // 32 caracteres tomado del texto
+  for (size_t n : sizes) {
+    std::cout << "\n=== Busqueda lineal con n = " << n << " ===\n";
+    std::string text = generate_random_text(n);
+    Benchmark::print_results(Benchmark::compare_scan(text, pattern));
+    Benchmark::print_results(
+        Benchmark::compare_scan(text, text.substr(n / 2, 32)));
+  }
+
+  // Construcción del Suffix Array: duplicación vs SA-IS en textos grandes
+  for (size_t n : {size_t(1000000), size_t(4000000)}) {
+    std::cout << "\n=== Construccion SA con n = " << n << " ===\n";
+    std::string text = generate_random_text(n);
+    Benchmark::print_results(Benchmark::compare_construction(text, pattern));
+  }
+
+  // Costo de memoria y velocidad de cada ancho de índice
+  {
+    size_t n = 4000000;
+    std::cout << "\n=== Anchos de indice con n = " << n << " ===\n";
+    std::string text = generate_random_text(n);
+    Benchmark::print_results(Benchmark::compare_index_widths(text, pattern));
+  }
+
+  // Búsqueda de patrones largos (256 caracteres) en texto repetitivo
+  {
+    size_t n = 4000000;
+    std::cout << "\n=== Busqueda LCP-LR con n = " << n << " ===\n";
+    std::string text = generate_repetitive_text(n, 4096);
+    std::vector<std::string> patterns;
+    for (int i = 0; i < 1000; ++i)
+      patterns.push_back(text.substr(rand() % (n - 256), 256));
+    Benchmark::print_results(Benchmark::compare_search_modes(text, patterns));
+  }
+
+  // Lote de 200k consultas cortas (8 a 24 caracteres) tomadas del texto
+  {
+    size_t n = 4000000;
+    std::cout << "\n=== Busqueda por lotes con n = " << n << " ===\n";
+    std::string text = generate_random_text(n);
+    std::vector<std::string> patterns;
+    for (int i = 0; i < 200000; ++i)
+      patterns.push_back(text.substr(rand() % (n - 24), 8 + rand() % 17));
+    Benchmark::print_results(Benchmark::compare_batch_search(text, patterns));
+  }
+
+  // Tabla de buckets por prefijo: tamaño y latencia por consulta
+  {
+    size_t n = 4000000;
+    std::cout << "\n=== Tabla de buckets con n = " << n << " ===\n";
+    std::string text;
+    text.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+      text += 'a' + (rand() % 26); // Alfabeto más amplio: buckets útiles
+    std::vector<std::string> patterns;
+    for (int i = 0; i < 100000; ++i)
+      patterns.push_back(text.substr(rand() % (n - 16), 6 + rand() % 10));
+    Benchmark::print_results(Benchmark::compare_prefix_tables(text, patterns));
+  }
+
+  // LCP: Kasai en caché contra la variante compacta
+  {
+    size_t n = 4000000;
+    std::cout << "\n=== LCP Array con n = " << n << " ===\n";
+    Benchmark::print_results(
+        Benchmark::compare_lcp_variants(generate_random_text(n)));
+  }
+
+  // Plagio entre dos documentos casi idénticos de 1 MB (0.1% de cambios)
+  {
+    size_t n = 1000000;
+    std::cout << "\n=== Plagio entre documentos casi identicos de " << n
+              << " caracteres ===\n";
+    std::string original = generate_random_text(n);
+    std::string copy = original;
+    for (size_t i = 0; i < n / 1000; ++i)
+      copy[rand() % n] = 'e';
+    Benchmark::print_results(Benchmark::measure_plagiarism(original, copy));
+  }
+
+  // Plagio entre dos documentos idénticos de 10 MB: el peor caso de solapes
+  {
+    size_t n = 10000000;
+    std::cout << "\n=== Plagio entre documentos identicos de " << n
+              << " caracteres ===\n";
+    std::string original = generate_random_text(n);
+    Benchmark::print_results(Benchmark::measure_plagiarism(original, original));
+  }
+
+  // Plagio entre N documentos: detectores por par contra SA generalizado
+  {
+    size_t documents = 40, length = 20000;
+    std::cout << "\n=== Plagio entre " << documents << " documentos de "
+              << length << " caracteres ===\n";
+    // Cada documento mezcla texto propio con pasajes de un fondo común
+    std::string shared = generate_random_text(200000);
+    std::vector<std::string> corpus;
+    for (size_t d = 0; d < documents; ++d) {
+      std::string document;
+      while (document.size() < length) {
+        if (rand() % 4 == 0)
+          document += shared.substr(rand() % (shared.size() - 500), 500);
+        else
+          document += generate_random_text(500);
+      }
+      corpus.push_back(document);
+    }
+    Benchmark::print_results(Benchmark::compare_multi_document(corpus));
+  }
+
+  // Filtro de huellas delante del detector: corpus de documentos sin
+  // relación salvo algunos pares con un pasaje copiado
+  {
+    size_t documents = 100, length = 4000, copies = 30;
+    std::cout << "\n=== Filtro de huellas sobre " << documents
+              << " documentos de " << length << " caracteres ===\n";
+    std::vector<std::string> corpus;
+    for (size_t d = 0; d < documents; ++d)
+      corpus.push_back(generate_random_text(length));
+    for (size_t c = 0; c < copies; ++c) {
+      size_t from = rand() % documents, to = rand() % documents;
+      std::string passage = corpus[from].substr(rand() % (length - 400), 400);
+      corpus[to].insert(rand() % corpus[to].size(), passage);
+    }
+    // Fragmentos de 20 o más, como en la consulta contra el corpus
+    Benchmark::print_results(Benchmark::compare_prefilter(corpus, 5.0, 20));
+  }
+
+  // Matching statistics de una consulta contra un texto indexado
+  {
+    size_t n = 4000000, q = 200000;
+    std::cout << "\n=== Matching statistics con n = " << n << " y consulta de "
+              << q << " ===\n";
+    std::string text = generate_random_text(n);
+    // Mitad pasajes del texto con un cambio cada ~40 caracteres, mitad azar
+    std::string query;
+    while (query.size() < q) {
+      if (rand() % 2 == 0) {
+        std::string passage = text.substr(rand() % (n - 1000), 1000);
+        for (size_t i = 0; i < passage.size(); i += 30 + rand() % 20)
+          passage[i] = 'e';
+        query += passage;
+      } else {
+        query += generate_random_text(1000);
+      }
+    }
+    Benchmark::print_results(
+        Benchmark::compare_matching_statistics(text, query));
+  }
+
+  // Un documento contra un corpus de referencia: detector por par contra
+  // un índice del corpus construido una vez
+  {
+    size_t documents = 1000, length = 10000;
+    std::cout << "\n=== Consulta contra un corpus de " << documents
+              << " documentos de " << length << " caracteres ===\n";
+    std::vector<std::string> corpus;
+    for (size_t d = 0; d < documents; ++d)
+      corpus.push_back(generate_random_text(length));
+    // La consulta copia pasajes de 500 caracteres de algunos documentos
+    std::string query;
+    while (query.size() < length) {
+      if (rand() % 2 == 0)
+        query += corpus[rand() % documents].substr(rand() % (length - 500),
+                                                   500);
+      else
+        query += generate_random_text(500);
+    }
+    // Con 4 letras, ventanas de 10 se repetirían al azar en 10 MB: se piden
+    // 20 caracteres
+    Benchmark::print_results(
+        Benchmark::compare_corpus_query(corpus, query, 20));
+  }
+
+  // FM-index: memoria contra latencia frente al Suffix Array
+  {
+    size_t n = 4000000;
+    std::cout << "\n=== FM-index con n = " << n << " ===\n";
+    std::string text = generate_random_text(n);
+    std::vector<std::string> patterns;
+    for (int i = 0; i < 10000; ++i)
+      patterns.push_back(text.substr(rand() % (n - 20), 10 + rand() % 8));
+    Benchmark::print_results(Benchmark::compare_fm_index(text, patterns));
+  }
+
+  // Texto que crece por bloques (registros): append contra reconstrucción
+  {
+    size_t n = 1000000, chunk = 32768;
+    std::cout << "\n=== Ingesta por bloques de " << chunk << " con n = " << n
+              << " ===\n";
+    std::string text = generate_random_text(n);
+    Benchmark::print_results(
+        Benchmark::compare_append(text, chunk, text.substr(n - 30, 20)));
+  }
+
+  // Índice más grande que la memoria disponible: construcción externa con
+  // un presupuesto de la cuarta parte del arreglo, sobre texto aleatorio y
+  // sobre un bloque de 1 KB repetido (sufijos con prefijos comunes largos)
+  {
+    size_t n = 4000000, budget = n;
+    std::pair<const char *, std::string> inputs[] = {
+        {"aleatorio", generate_random_text(n)},
+        {"repetitivo", generate_repetitive_text(n, 1024)}};
+    for (const auto &[name, text] : inputs) {
+      std::cout << "\n=== Construccion externa con n = " << n << " (" << name
+                << ") y presupuesto de " << budget / 1024 << " KB ===\n";
+      Benchmark::print_results(
+          Benchmark::compare_external(text, budget, text.substr(n / 2, 20)));
+    }
+  }
+
+  // Núcleo de comparación: escalar contra SSE2/AVX2, aislado y dentro del
+  // LCP y la búsqueda sobre un texto con prefijos comunes largos
+  {
+    std::cout << "\n=== Comparacion de prefijos (nucleo en uso: "
+              << SuffixCompare::name(SuffixCompare::kernel()) << ") ===\n";
+    Benchmark::print_results(
+        Benchmark::compare_mismatch({16, 64, 256, 1024, 4096, 65536}));
+    size_t n = 1000000;
+    std::string text = generate_repetitive_text(n, 5000);
+    Benchmark::print_results(
+        Benchmark::compare_lcp_kernels(text, text.substr(n / 2, 2000)));
+  }
+
+  // Arranque: construir el índice contra abrirlo ya guardado (mmap)
+  {
+    size_t n = 4000000;
+    std::cout << "\n=== Arranque desde disco con n = " << n << " ===\n";
+    std::string text = generate_random_text(n);
+    Benchmark::print_results(
+        Benchmark::compare_startup(text, text.substr(n / 2, 20)));
+  }
+
+  // Construcción paralela: tiempo por número de hilos (1, 2, 4, ... núcleos)
+  {
+    size_t n = 4000000;
+    std::cout << "\n=== Construccion paralela con n = " << n << " ===\n";
+    std::vector<unsigned> thread_counts;
+    for (unsigned t = 1; t < ThreadPool::default_threads(); t *= 2)
+      thread_counts.push_back(t);
+    thread_counts.push_back(ThreadPool::default_threads());
+    std::string text = generate_random_text(n);
+    Benchmark::print_results(
+        Benchmark::construction_scaling(text, thread_counts));
+  }
+
   return 0;
 }